@@ -0,0 +1,862 @@
+
+#include "fold.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ** Internal Helpers **
+
+static ASTNode *fold_stmt(Folder *f, ASTNode *node);
+static void fold_expr(Folder *f, ASTNode *node);
+
+// Only plain `int` literals are folded: suffixed or typed literals keep their
+// own C semantics and are left untouched.
+static int is_int_literal(ASTNode *node)
+{
+    return node && node->type == NODE_EXPR_LITERAL && node->literal.type_kind == LITERAL_INT &&
+           (!node->type_info || node->type_info->kind == TYPE_INT) &&
+           node->literal.int_val <= INT_MAX;
+}
+
+static void make_int_literal(ASTNode *node, long long val)
+{
+    node->type = NODE_EXPR_LITERAL;
+    node->literal.type_kind = LITERAL_INT;
+    node->literal.int_val = (unsigned long long)val;
+    node->literal.float_val = 0;
+    node->literal.string_val = NULL;
+    node->type_info = type_new(TYPE_INT);
+    node->resolved_type = xstrdup("int");
+}
+
+// Value of an integer constant: a plain int literal or the negation of one,
+// which is how `-5` parses and how negative results are written back.
+static int int_const_value(ASTNode *node, long long *out)
+{
+    if (is_int_literal(node))
+    {
+        *out = (long long)node->literal.int_val;
+        return 1;
+    }
+    if (node && node->type == NODE_EXPR_UNARY && strcmp(node->unary.op, "-") == 0 &&
+        is_int_literal(node->unary.operand))
+    {
+        *out = -(long long)node->unary.operand->literal.int_val;
+        return 1;
+    }
+    return 0;
+}
+
+static void make_int_const(ASTNode *node, long long val)
+{
+    if (val >= 0)
+    {
+        make_int_literal(node, val);
+        return;
+    }
+    ASTNode *lit = ast_create(NODE_EXPR_LITERAL);
+    lit->token = node->token;
+    make_int_literal(lit, -val);
+    node->type = NODE_EXPR_UNARY;
+    node->unary.op = xstrdup("-");
+    node->unary.operand = lit;
+    node->type_info = type_new(TYPE_INT);
+    node->resolved_type = xstrdup("int");
+}
+
+// Evaluates `a op b` with C int semantics. Returns 0 when the operation is not
+// foldable (unknown operator, UB or implementation-defined behaviour in C, or a
+// result outside [-INT_MAX, INT_MAX]).
+static int eval_int_binary(const char *op, long long a, long long b, long long *out)
+{
+    long long r;
+    if (strcmp(op, "+") == 0)
+    {
+        r = a + b;
+    }
+    else if (strcmp(op, "-") == 0)
+    {
+        r = a - b;
+    }
+    else if (strcmp(op, "*") == 0)
+    {
+        r = a * b;
+    }
+    else if (strcmp(op, "/") == 0 || strcmp(op, "%") == 0)
+    {
+        if (b == 0)
+        {
+            return 0;
+        }
+        r = (op[0] == '/') ? a / b : a % b;
+    }
+    else if (strcmp(op, "<<") == 0)
+    {
+        if (a < 0 || b < 0 || b >= 31)
+        {
+            return 0;
+        }
+        r = a << b;
+    }
+    else if (strcmp(op, ">>") == 0)
+    {
+        if (a < 0 || b < 0 || b >= 31)
+        {
+            return 0;
+        }
+        r = a >> b;
+    }
+    else if (strcmp(op, "&") == 0)
+    {
+        r = a & b;
+    }
+    else if (strcmp(op, "|") == 0)
+    {
+        r = a | b;
+    }
+    else if (strcmp(op, "^") == 0)
+    {
+        r = a ^ b;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (r < -INT_MAX || r > INT_MAX)
+    {
+        return 0;
+    }
+    *out = r;
+    return 1;
+}
+
+// Folds a binary node whose operands have already been folded.
+static int fold_binary(ASTNode *node)
+{
+    long long a;
+    long long b;
+    long long val;
+    if (!int_const_value(node->binary.left, &a) || !int_const_value(node->binary.right, &b) ||
+        !eval_int_binary(node->binary.op, a, b, &val))
+    {
+        return 0;
+    }
+    make_int_const(node, val);
+    return 1;
+}
+
+// Folds `-c` and `~c` on an already folded constant. A negated plain literal is
+// already in canonical form and is left alone.
+static int fold_unary(ASTNode *node)
+{
+    long long v;
+    if (!int_const_value(node->unary.operand, &v))
+    {
+        return 0;
+    }
+    if (strcmp(node->unary.op, "-") == 0)
+    {
+        if (is_int_literal(node->unary.operand))
+        {
+            return 0;
+        }
+        make_int_const(node, -v);
+        return 1;
+    }
+    if (strcmp(node->unary.op, "~") == 0 && ~v >= -INT_MAX)
+    {
+        make_int_const(node, ~v);
+        return 1;
+    }
+    return 0;
+}
+
+// Truth value of a condition: 1 or 0 when known at compile time, -1 otherwise.
+// Comparisons and logical operators are only evaluated here, never rewritten,
+// because their result has type bool rather than int.
+static int fold_truth(ASTNode *node)
+{
+    if (!node)
+    {
+        return -1;
+    }
+
+    switch (node->type)
+    {
+    case NODE_EXPR_LITERAL:
+        if (is_int_literal(node))
+        {
+            return node->literal.int_val != 0;
+        }
+        return -1;
+    case NODE_EXPR_VAR:
+        if (strcmp(node->var_ref.name, "true") == 0)
+        {
+            return 1;
+        }
+        if (strcmp(node->var_ref.name, "false") == 0)
+        {
+            return 0;
+        }
+        return -1;
+    case NODE_EXPR_UNARY:
+    {
+        long long c;
+        if (int_const_value(node, &c))
+        {
+            return c != 0;
+        }
+        if (strcmp(node->unary.op, "!") != 0)
+        {
+            return -1;
+        }
+        int v = fold_truth(node->unary.operand);
+        return v < 0 ? -1 : !v;
+    }
+    case NODE_EXPR_BINARY:
+    {
+        char *op = node->binary.op;
+        if (strcmp(op, "&&") == 0 || strcmp(op, "||") == 0)
+        {
+            // The right operand is only evaluated if the left one does not
+            // decide the result, so `0 && f()` is false without calling f().
+            int lv = fold_truth(node->binary.left);
+            int rv = fold_truth(node->binary.right);
+            if (op[0] == '&')
+            {
+                if (lv == 0)
+                {
+                    return 0;
+                }
+                return (lv == 1 && rv >= 0) ? rv : -1;
+            }
+            if (lv == 1)
+            {
+                return 1;
+            }
+            return (lv == 0 && rv >= 0) ? rv : -1;
+        }
+
+        long long a;
+        long long b;
+        if (!int_const_value(node->binary.left, &a) || !int_const_value(node->binary.right, &b))
+        {
+            return -1;
+        }
+        if (strcmp(op, "==") == 0)
+        {
+            return a == b;
+        }
+        if (strcmp(op, "!=") == 0)
+        {
+            return a != b;
+        }
+        if (strcmp(op, "<") == 0)
+        {
+            return a < b;
+        }
+        if (strcmp(op, ">") == 0)
+        {
+            return a > b;
+        }
+        if (strcmp(op, "<=") == 0)
+        {
+            return a <= b;
+        }
+        if (strcmp(op, ">=") == 0)
+        {
+            return a >= b;
+        }
+        return -1;
+    }
+    default:
+        return -1;
+    }
+}
+
+// A branch holding a label may be the target of a goto from live code.
+static int contains_label(ASTNode *node)
+{
+    while (node)
+    {
+        switch (node->type)
+        {
+        case NODE_LABEL:
+            return 1;
+        case NODE_BLOCK:
+            if (contains_label(node->block.statements))
+            {
+                return 1;
+            }
+            break;
+        case NODE_IF:
+            if (contains_label(node->if_stmt.then_body) ||
+                contains_label(node->if_stmt.else_body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_WHILE:
+            if (contains_label(node->while_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_DO_WHILE:
+            if (contains_label(node->do_while_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_FOR:
+            if (contains_label(node->for_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_FOR_RANGE:
+            if (contains_label(node->for_range.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_LOOP:
+            if (contains_label(node->loop_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_REPEAT:
+            if (contains_label(node->repeat_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_UNLESS:
+            if (contains_label(node->unless_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        case NODE_GUARD:
+            if (contains_label(node->guard_stmt.body))
+            {
+                return 1;
+            }
+            break;
+        default:
+            break;
+        }
+        node = node->next;
+    }
+    return 0;
+}
+
+// Wraps a surviving branch in a block so its declarations stay scoped.
+static ASTNode *as_block(ASTNode *node)
+{
+    if (!node || node->type == NODE_BLOCK)
+    {
+        return node;
+    }
+    ASTNode *b = ast_create(NODE_BLOCK);
+    b->token = node->token;
+    b->block.statements = node;
+    node->next = NULL;
+    return b;
+}
+
+// Folds a statement in a slot that must stay occupied (e.g. a loop body).
+static ASTNode *fold_single(Folder *f, ASTNode *node)
+{
+    if (!node)
+    {
+        return NULL;
+    }
+    ASTNode *r = fold_stmt(f, node);
+    if (!r)
+    {
+        r = ast_create(NODE_BLOCK);
+        r->token = node->token;
+    }
+    return r;
+}
+
+static void fold_stmt_list(Folder *f, ASTNode **link)
+{
+    while (*link)
+    {
+        ASTNode *s = *link;
+        ASTNode *next = s->next;
+        ASTNode *r = fold_stmt(f, s);
+        if (!r)
+        {
+            *link = next;
+            continue;
+        }
+        r->next = next;
+        *link = r;
+        link = &r->next;
+    }
+}
+
+static void fold_expr_list(Folder *f, ASTNode *list)
+{
+    while (list)
+    {
+        fold_expr(f, list);
+        list = list->next;
+    }
+}
+
+// Case/branch bodies may either be an expression or a block.
+static void fold_body(Folder *f, ASTNode *body)
+{
+    if (body && body->type == NODE_BLOCK)
+    {
+        fold_stmt_list(f, &body->block.statements);
+    }
+    else
+    {
+        fold_expr(f, body);
+    }
+}
+
+// Returns 1 if every alternative of an `A|B|...` pattern is a plain integer,
+// storing whether any of them equals `val` in *hit. Alternatives may be
+// separated by `|` or `||` and surrounded by spaces.
+static int int_pattern_matches(const char *pattern, long long val, int *hit)
+{
+    *hit = 0;
+    const char *p = pattern;
+    int seen = 0;
+    while (*p)
+    {
+        while (*p == ' ' || *p == '|')
+        {
+            p++;
+        }
+        if (!*p)
+        {
+            break;
+        }
+        const char *digits = (*p == '-') ? p + 1 : p;
+        if (*digits < '0' || *digits > '9')
+        {
+            return 0;
+        }
+        char *end = NULL;
+        long long v = strtoll(p, &end, 0);
+        while (*end == ' ')
+        {
+            end++;
+        }
+        if (end == p || (*end && *end != '|'))
+        {
+            return 0;
+        }
+        if (v == val)
+        {
+            *hit = 1;
+        }
+        seen = 1;
+        p = end;
+    }
+    return seen;
+}
+
+static void prune_match(Folder *f, ASTNode *node)
+{
+    // Arms after an unguarded wildcard can never be selected.
+    ASTNode *c = node->match_stmt.cases;
+    while (c)
+    {
+        if (c->match_case.is_default && !c->match_case.guard && c->next)
+        {
+            for (ASTNode *d = c->next; d; d = d->next)
+            {
+                f->pruned_branches++;
+            }
+            c->next = NULL;
+            break;
+        }
+        c = c->next;
+    }
+
+    // A constant integer scrutinee selects exactly one arm.
+    long long scrutinee;
+    if (!int_const_value(node->match_stmt.expr, &scrutinee))
+    {
+        return;
+    }
+    ASTNode *selected = NULL;
+    for (c = node->match_stmt.cases; c; c = c->next)
+    {
+        if (c->match_case.guard)
+        {
+            return;
+        }
+        int hit = c->match_case.is_default;
+        if (!hit && !int_pattern_matches(c->match_case.pattern, scrutinee, &hit))
+        {
+            return;
+        }
+        if (hit && !selected)
+        {
+            selected = c;
+        }
+    }
+    if (!selected || selected->match_case.binding_count > 0)
+    {
+        return;
+    }
+
+    for (c = node->match_stmt.cases; c; c = c->next)
+    {
+        if (c != selected)
+        {
+            f->pruned_branches++;
+        }
+    }
+    selected->next = NULL;
+    selected->match_case.pattern = "_";
+    selected->match_case.is_default = 1;
+    node->match_stmt.cases = selected;
+}
+
+static void fold_expr(Folder *f, ASTNode *node)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    switch (node->type)
+    {
+    case NODE_EXPR_BINARY:
+        fold_expr(f, node->binary.left);
+        fold_expr(f, node->binary.right);
+        if (fold_binary(node))
+        {
+            f->folded_exprs++;
+        }
+        break;
+    case NODE_EXPR_UNARY:
+        fold_expr(f, node->unary.operand);
+        if (fold_unary(node))
+        {
+            f->folded_exprs++;
+        }
+        break;
+    case NODE_AWAIT:
+        fold_expr(f, node->unary.operand);
+        break;
+    case NODE_EXPR_CALL:
+        fold_expr(f, node->call.callee);
+        fold_expr_list(f, node->call.args);
+        break;
+    case NODE_EXPR_MEMBER:
+        fold_expr(f, node->member.target);
+        break;
+    case NODE_EXPR_INDEX:
+        fold_expr(f, node->index.array);
+        fold_expr(f, node->index.index);
+        break;
+    case NODE_EXPR_SLICE:
+        fold_expr(f, node->slice.array);
+        fold_expr(f, node->slice.start);
+        fold_expr(f, node->slice.end);
+        break;
+    case NODE_EXPR_CAST:
+        fold_expr(f, node->cast.expr);
+        break;
+    case NODE_TERNARY:
+        fold_expr(f, node->ternary.cond);
+        fold_expr(f, node->ternary.true_expr);
+        fold_expr(f, node->ternary.false_expr);
+        break;
+    case NODE_EXPR_STRUCT_INIT:
+    {
+        ASTNode *fld = node->struct_init.fields;
+        while (fld)
+        {
+            fold_expr(f, fld->var_decl.init_expr);
+            fld = fld->next;
+        }
+        break;
+    }
+    case NODE_EXPR_ARRAY_LITERAL:
+        fold_expr_list(f, node->array_literal.elements);
+        break;
+    case NODE_TRY:
+        fold_expr(f, node->try_stmt.expr);
+        break;
+    case NODE_LAMBDA:
+        fold_body(f, node->lambda.body);
+        break;
+    case NODE_MATCH:
+    {
+        fold_expr(f, node->match_stmt.expr);
+        ASTNode *c = node->match_stmt.cases;
+        while (c)
+        {
+            fold_expr(f, c->match_case.guard);
+            fold_body(f, c->match_case.body);
+            c = c->next;
+        }
+        prune_match(f, node);
+        break;
+    }
+    case NODE_BLOCK:
+        fold_stmt_list(f, &node->block.statements);
+        break;
+    case NODE_IF:
+        // If-expressions produce a value; only their operands are folded.
+        fold_expr(f, node->if_stmt.condition);
+        fold_body(f, node->if_stmt.then_body);
+        fold_body(f, node->if_stmt.else_body);
+        break;
+    default:
+        break;
+    }
+}
+
+static void fold_function(Folder *f, ASTNode *node)
+{
+    if (!node->func.body || node->func.generic_params)
+    {
+        return;
+    }
+    fold_stmt(f, node->func.body);
+}
+
+// Folds a statement. Returns the node that replaces it in its list, or NULL
+// if the statement can never execute and should be dropped.
+static ASTNode *fold_stmt(Folder *f, ASTNode *node)
+{
+    if (!node)
+    {
+        return NULL;
+    }
+
+    switch (node->type)
+    {
+    case NODE_FUNCTION:
+        fold_function(f, node);
+        break;
+    case NODE_IMPL:
+        for (ASTNode *m = node->impl.methods; m; m = m->next)
+        {
+            fold_stmt(f, m);
+        }
+        break;
+    case NODE_IMPL_TRAIT:
+        for (ASTNode *m = node->impl_trait.methods; m; m = m->next)
+        {
+            fold_stmt(f, m);
+        }
+        break;
+    case NODE_TEST:
+        fold_stmt(f, node->test_stmt.body);
+        break;
+    case NODE_BLOCK:
+        fold_stmt_list(f, &node->block.statements);
+        break;
+    case NODE_VAR_DECL:
+    case NODE_CONST:
+        fold_expr(f, node->var_decl.init_expr);
+        break;
+    case NODE_DESTRUCT_VAR:
+        fold_expr(f, node->destruct.init_expr);
+        fold_stmt(f, node->destruct.else_block);
+        break;
+    case NODE_RETURN:
+        fold_expr(f, node->ret.value);
+        break;
+    case NODE_IF:
+    {
+        fold_expr(f, node->if_stmt.condition);
+        int truth = fold_truth(node->if_stmt.condition);
+        if (truth == 1 && !contains_label(node->if_stmt.else_body))
+        {
+            f->pruned_branches++;
+            return as_block(fold_single(f, node->if_stmt.then_body));
+        }
+        if (truth == 0 && !contains_label(node->if_stmt.then_body))
+        {
+            f->pruned_branches++;
+            return as_block(fold_stmt(f, node->if_stmt.else_body));
+        }
+        node->if_stmt.then_body = fold_single(f, node->if_stmt.then_body);
+        node->if_stmt.else_body = fold_stmt(f, node->if_stmt.else_body);
+        break;
+    }
+    case NODE_WHILE:
+        fold_expr(f, node->while_stmt.condition);
+        if (fold_truth(node->while_stmt.condition) == 0 &&
+            !contains_label(node->while_stmt.body))
+        {
+            f->pruned_branches++;
+            return NULL;
+        }
+        node->while_stmt.body = fold_single(f, node->while_stmt.body);
+        break;
+    case NODE_DO_WHILE:
+        node->do_while_stmt.body = fold_single(f, node->do_while_stmt.body);
+        fold_expr(f, node->do_while_stmt.condition);
+        break;
+    case NODE_FOR:
+        fold_stmt(f, node->for_stmt.init);
+        fold_expr(f, node->for_stmt.condition);
+        fold_expr(f, node->for_stmt.step);
+        node->for_stmt.body = fold_single(f, node->for_stmt.body);
+        break;
+    case NODE_FOR_RANGE:
+        fold_expr(f, node->for_range.start);
+        fold_expr(f, node->for_range.end);
+        node->for_range.body = fold_single(f, node->for_range.body);
+        break;
+    case NODE_LOOP:
+        node->loop_stmt.body = fold_single(f, node->loop_stmt.body);
+        break;
+    case NODE_REPEAT:
+        node->repeat_stmt.body = fold_single(f, node->repeat_stmt.body);
+        break;
+    case NODE_UNLESS:
+    {
+        fold_expr(f, node->unless_stmt.condition);
+        int truth = fold_truth(node->unless_stmt.condition);
+        if (truth == 1 && !contains_label(node->unless_stmt.body))
+        {
+            f->pruned_branches++;
+            return NULL;
+        }
+        if (truth == 0)
+        {
+            f->pruned_branches++;
+            return as_block(fold_single(f, node->unless_stmt.body));
+        }
+        node->unless_stmt.body = fold_single(f, node->unless_stmt.body);
+        break;
+    }
+    case NODE_GUARD:
+    {
+        fold_expr(f, node->guard_stmt.condition);
+        int truth = fold_truth(node->guard_stmt.condition);
+        if (truth == 1 && !contains_label(node->guard_stmt.body))
+        {
+            f->pruned_branches++;
+            return NULL;
+        }
+        if (truth == 0)
+        {
+            f->pruned_branches++;
+            return as_block(fold_single(f, node->guard_stmt.body));
+        }
+        node->guard_stmt.body = fold_single(f, node->guard_stmt.body);
+        break;
+    }
+    case NODE_ASSERT:
+        fold_expr(f, node->assert_stmt.condition);
+        break;
+    case NODE_DEFER:
+        node->defer_stmt.stmt = fold_single(f, node->defer_stmt.stmt);
+        break;
+    case NODE_REPL_PRINT:
+        fold_expr(f, node->repl_print.expr);
+        break;
+    case NODE_MATCH:
+    case NODE_EXPR_BINARY:
+    case NODE_EXPR_UNARY:
+    case NODE_EXPR_CALL:
+    case NODE_EXPR_MEMBER:
+    case NODE_EXPR_INDEX:
+    case NODE_AWAIT:
+    case NODE_TRY:
+    case NODE_TERNARY:
+        // Expression statements.
+        fold_expr(f, node);
+        break;
+    default:
+        break;
+    }
+    return node;
+}
+
+// ** Public API **
+
+int fold_const_expr(ASTNode *node, long long *value)
+{
+    if (!node)
+    {
+        return 0;
+    }
+    if (node->type == NODE_EXPR_BINARY)
+    {
+        fold_const_expr(node->binary.left, value);
+        fold_const_expr(node->binary.right, value);
+        fold_binary(node);
+    }
+    else if (node->type == NODE_EXPR_UNARY)
+    {
+        fold_const_expr(node->unary.operand, value);
+        fold_unary(node);
+    }
+    return int_const_value(node, value);
+}
+
+void fold_program(ParserContext *ctx, ASTNode *root)
+{
+    Folder f = {0};
+    f.pctx = ctx;
+
+    ASTNode *fn = ctx->instantiated_funcs;
+    while (fn)
+    {
+        fold_stmt(&f, fn);
+        fn = fn->next;
+    }
+
+    StructRef *ref = ctx->parsed_funcs_list;
+    while (ref)
+    {
+        fold_stmt(&f, ref->node);
+        ref = ref->next;
+    }
+
+    ref = ctx->parsed_impls_list;
+    while (ref)
+    {
+        fold_stmt(&f, ref->node);
+        ref = ref->next;
+    }
+
+    ref = ctx->parsed_globals_list;
+    while (ref)
+    {
+        fold_stmt(&f, ref->node);
+        ref = ref->next;
+    }
+
+    ASTNode *kids = root ? root->root.children : NULL;
+    while (kids && kids->type == NODE_ROOT)
+    {
+        kids = kids->root.children;
+    }
+    while (kids)
+    {
+        if (kids->type == NODE_TEST)
+        {
+            fold_stmt(&f, kids);
+        }
+        kids = kids->next;
+    }
+
+    if (g_config.verbose)
+    {
+        printf("[zc] Folded %d constant expressions, pruned %d unreachable branches.\n",
+               f.folded_exprs, f.pruned_branches);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef FOLD_H
+#define FOLD_H
+
+#include "ast.h"
+#include "parser.h"
+
+/**
+ * @brief Constant Folding Context.
+ *
+ * State of the folding pass that runs at the start of lowering. It evaluates
+ * integer constant expressions (including inlined `def` values) and removes
+ * statements and match arms that can never execute, so neither the emitted C
+ * nor the downstream C compiler has to deal with them.
+ */
+typedef struct Folder
+{
+    ParserContext *pctx; ///< Reference to global parser context.
+    int folded_exprs;    ///< Expressions replaced by a literal.
+    int pruned_branches; ///< Statements and match arms removed as unreachable.
+} Folder;
+
+/**
+ * @brief Folds an integer constant expression in place.
+ *
+ * Only `int` arithmetic whose operands and result stay within
+ * [-INT_MAX, INT_MAX] is evaluated, so the folded constant behaves exactly
+ * like the expression it replaces in C. Negative results are written back as
+ * a unary minus applied to a literal.
+ *
+ * @param node Expression to fold (may be NULL).
+ * @param value Receives the constant's value on success.
+ * @return 1 if the node is an integer constant after folding, 0 otherwise.
+ */
+int fold_const_expr(ASTNode *node, long long *value);
+
+/**
+ * @brief Constant folding and dead-branch elimination entry point.
+ *
+ * Walks the same emission set as lower_program() and rewrites it in place.
+ *
+ * @param ctx Global parser context.
+ * @param root Root AST node of the program.
+ */
+void fold_program(ParserContext *ctx, ASTNode *root);
+
+#endif // FOLD_H
@@ -0,0 +1,363 @@
+
+#include "lower.h"
+#include "fold.h"
+#include "../codegen/codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ** Internal Helpers **
+
+static void lower_stmt(Lowerer *lw, ASTNode *node);
+static int lower_expr(Lowerer *lw, ASTNode *node);
+
+static int is_usable_type_str(const char *t)
+{
+    return t && strcmp(t, "unknown") != 0 && strcmp(t, "__auto_type") != 0;
+}
+
+// Attach the resolved type to an expression node. Existing annotations from
+// the parser always win; we only fill the gaps.
+static void lower_annotate(Lowerer *lw, ASTNode *node, char *type_str)
+{
+    if (!is_usable_type_str(type_str))
+    {
+        return;
+    }
+    if (!node->resolved_type)
+    {
+        node->resolved_type = type_str;
+    }
+    if (!node->type_info)
+    {
+        node->type_info = type_from_string_helper(type_str);
+    }
+    lw->typed_count++;
+}
+
+static int lower_expr_list(Lowerer *lw, ASTNode *list)
+{
+    int ok = 1;
+    while (list)
+    {
+        ok &= lower_expr(lw, list);
+        list = list->next;
+    }
+    return ok;
+}
+
+static void lower_stmt_list(Lowerer *lw, ASTNode *list)
+{
+    while (list)
+    {
+        lower_stmt(lw, list);
+        list = list->next;
+    }
+}
+
+// A variable reference can only be typed here if the parser resolved it while
+// its scope was live. Anything else depends on the codegen-time symbol table.
+static int lower_var(Lowerer *lw, ASTNode *node)
+{
+    if (node->resolved_type)
+    {
+        return strcmp(node->resolved_type, "unknown") != 0;
+    }
+    if (node->type_info && node->type_info->kind != TYPE_UNKNOWN)
+    {
+        lower_annotate(lw, node, type_to_string(node->type_info));
+        return 1;
+    }
+    lw->deferred_count++;
+    return 0;
+}
+
+// Lowers a case/branch body which may either be an expression or a block.
+static int lower_body(Lowerer *lw, ASTNode *body)
+{
+    if (!body)
+    {
+        return 1;
+    }
+    if (body->type == NODE_BLOCK)
+    {
+        lower_stmt(lw, body);
+        return 1;
+    }
+    return lower_expr(lw, body);
+}
+
+// Lowers an expression tree bottom-up. Returns 1 if the type of the node does
+// not depend on the lexical scope, i.e. it is safe to compute (and cache) now.
+static int lower_expr(Lowerer *lw, ASTNode *node)
+{
+    if (!node)
+    {
+        return 1;
+    }
+
+    int ok = 1;
+    switch (node->type)
+    {
+    case NODE_EXPR_LITERAL:
+        break;
+    case NODE_EXPR_VAR:
+        return lower_var(lw, node);
+    case NODE_EXPR_BINARY:
+        ok &= lower_expr(lw, node->binary.left);
+        ok &= lower_expr(lw, node->binary.right);
+        break;
+    case NODE_EXPR_UNARY:
+    case NODE_AWAIT:
+        ok &= lower_expr(lw, node->unary.operand);
+        break;
+    case NODE_EXPR_CALL:
+        ok &= lower_expr(lw, node->call.callee);
+        ok &= lower_expr_list(lw, node->call.args);
+        break;
+    case NODE_EXPR_MEMBER:
+        ok &= lower_expr(lw, node->member.target);
+        break;
+    case NODE_EXPR_INDEX:
+        ok &= lower_expr(lw, node->index.array);
+        ok &= lower_expr(lw, node->index.index);
+        break;
+    case NODE_EXPR_SLICE:
+        ok &= lower_expr(lw, node->slice.array);
+        ok &= lower_expr(lw, node->slice.start);
+        ok &= lower_expr(lw, node->slice.end);
+        break;
+    case NODE_EXPR_CAST:
+        ok &= lower_expr(lw, node->cast.expr);
+        break;
+    case NODE_EXPR_SIZEOF:
+        lower_expr(lw, node->size_of.expr);
+        break;
+    case NODE_TERNARY:
+        ok &= lower_expr(lw, node->ternary.cond);
+        ok &= lower_expr(lw, node->ternary.true_expr);
+        ok &= lower_expr(lw, node->ternary.false_expr);
+        break;
+    case NODE_EXPR_STRUCT_INIT:
+    {
+        ASTNode *f = node->struct_init.fields;
+        while (f)
+        {
+            lower_expr(lw, f->var_decl.init_expr);
+            f = f->next;
+        }
+        break;
+    }
+    case NODE_EXPR_ARRAY_LITERAL:
+        ok &= lower_expr_list(lw, node->array_literal.elements);
+        break;
+    case NODE_TRY:
+        ok &= lower_expr(lw, node->try_stmt.expr);
+        break;
+    case NODE_LAMBDA:
+        lower_body(lw, node->lambda.body);
+        return 1;
+    case NODE_MATCH:
+    {
+        ok &= lower_expr(lw, node->match_stmt.expr);
+        ASTNode *c = node->match_stmt.cases;
+        while (c)
+        {
+            lower_expr(lw, c->match_case.guard);
+            // Case bodies may reference pattern bindings, which only exist
+            // in the emitted C.
+            ok &= lower_body(lw, c->match_case.body);
+            c = c->next;
+        }
+        break;
+    }
+    case NODE_BLOCK:
+    case NODE_IF:
+        // Block and if expressions: lower the statements but leave typing to codegen.
+        lower_stmt(lw, node);
+        return 0;
+    default:
+        return 0;
+    }
+
+    if (!ok)
+    {
+        lw->deferred_count++;
+        return 0;
+    }
+
+    if (!node->resolved_type || !node->type_info)
+    {
+        lower_annotate(lw, node, infer_type(lw->pctx, node));
+    }
+    return 1;
+}
+
+static void lower_function(Lowerer *lw, ASTNode *node)
+{
+    if (!node->func.body || node->func.generic_params)
+    {
+        return;
+    }
+    lower_stmt(lw, node->func.body);
+}
+
+static void lower_stmt(Lowerer *lw, ASTNode *node)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    switch (node->type)
+    {
+    case NODE_FUNCTION:
+        lower_function(lw, node);
+        break;
+    case NODE_IMPL:
+        lower_stmt_list(lw, node->impl.methods);
+        break;
+    case NODE_IMPL_TRAIT:
+        lower_stmt_list(lw, node->impl_trait.methods);
+        break;
+    case NODE_TEST:
+        lower_stmt(lw, node->test_stmt.body);
+        break;
+    case NODE_BLOCK:
+        lower_stmt_list(lw, node->block.statements);
+        break;
+    case NODE_VAR_DECL:
+    case NODE_CONST:
+        lower_expr(lw, node->var_decl.init_expr);
+        break;
+    case NODE_DESTRUCT_VAR:
+        lower_expr(lw, node->destruct.init_expr);
+        lower_stmt(lw, node->destruct.else_block);
+        break;
+    case NODE_RETURN:
+        lower_expr(lw, node->ret.value);
+        break;
+    case NODE_IF:
+        lower_expr(lw, node->if_stmt.condition);
+        lower_body(lw, node->if_stmt.then_body);
+        lower_body(lw, node->if_stmt.else_body);
+        break;
+    case NODE_WHILE:
+        lower_expr(lw, node->while_stmt.condition);
+        lower_stmt(lw, node->while_stmt.body);
+        break;
+    case NODE_DO_WHILE:
+        lower_stmt(lw, node->do_while_stmt.body);
+        lower_expr(lw, node->do_while_stmt.condition);
+        break;
+    case NODE_FOR:
+        lower_stmt(lw, node->for_stmt.init);
+        lower_expr(lw, node->for_stmt.condition);
+        lower_expr(lw, node->for_stmt.step);
+        lower_stmt(lw, node->for_stmt.body);
+        break;
+    case NODE_FOR_RANGE:
+        lower_expr(lw, node->for_range.start);
+        lower_expr(lw, node->for_range.end);
+        lower_stmt(lw, node->for_range.body);
+        break;
+    case NODE_LOOP:
+        lower_stmt(lw, node->loop_stmt.body);
+        break;
+    case NODE_REPEAT:
+        lower_stmt(lw, node->repeat_stmt.body);
+        break;
+    case NODE_UNLESS:
+        lower_expr(lw, node->unless_stmt.condition);
+        lower_stmt(lw, node->unless_stmt.body);
+        break;
+    case NODE_GUARD:
+        lower_expr(lw, node->guard_stmt.condition);
+        lower_stmt(lw, node->guard_stmt.body);
+        break;
+    case NODE_ASSERT:
+        lower_expr(lw, node->assert_stmt.condition);
+        break;
+    case NODE_DEFER:
+        lower_stmt(lw, node->defer_stmt.stmt);
+        break;
+    case NODE_REPL_PRINT:
+        lower_expr(lw, node->repl_print.expr);
+        break;
+    case NODE_MATCH:
+    case NODE_EXPR_BINARY:
+    case NODE_EXPR_UNARY:
+    case NODE_EXPR_CALL:
+    case NODE_EXPR_MEMBER:
+    case NODE_EXPR_INDEX:
+    case NODE_AWAIT:
+    case NODE_TRY:
+    case NODE_TERNARY:
+        // Expression statements.
+        lower_expr(lw, node);
+        break;
+    default:
+        break;
+    }
+}
+
+// ** Entry Point **
+
+void lower_program(ParserContext *ctx, ASTNode *root)
+{
+    Lowerer lw = {0};
+    lw.pctx = ctx;
+
+    // Fold constants and drop dead branches first so typing only sees live code.
+    fold_program(ctx, root);
+
+    // Same emission set as codegen_node(): instantiated generics, parsed
+    // functions and impls, plus root-level tests and globals.
+    ASTNode *fn = ctx->instantiated_funcs;
+    while (fn)
+    {
+        lower_stmt(&lw, fn);
+        fn = fn->next;
+    }
+
+    StructRef *ref = ctx->parsed_funcs_list;
+    while (ref)
+    {
+        lower_stmt(&lw, ref->node);
+        ref = ref->next;
+    }
+
+    ref = ctx->parsed_impls_list;
+    while (ref)
+    {
+        lower_stmt(&lw, ref->node);
+        ref = ref->next;
+    }
+
+    ref = ctx->parsed_globals_list;
+    while (ref)
+    {
+        lower_stmt(&lw, ref->node);
+        ref = ref->next;
+    }
+
+    ASTNode *kids = root ? root->root.children : NULL;
+    while (kids && kids->type == NODE_ROOT)
+    {
+        kids = kids->root.children;
+    }
+    while (kids)
+    {
+        if (kids->type == NODE_TEST)
+        {
+            lower_stmt(&lw, kids);
+        }
+        kids = kids->next;
+    }
+
+    if (g_config.verbose)
+    {
+        printf("[zc] Lowered %d typed expressions (%d left to codegen inference).\n",
+               lw.typed_count, lw.deferred_count);
+    }
+}
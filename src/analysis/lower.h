@@ -0,0 +1,34 @@
+#ifndef LOWER_H
+#define LOWER_H
+
+#include "ast.h"
+#include "parser.h"
+
+/**
+ * @brief Lowering Context.
+ *
+ * Holds the state of the typed lowering pass that runs between validation and
+ * C emission. The pass walks exactly the bodies codegen is going to emit and
+ * attaches a resolved type to every expression it can type without a lexical
+ * scope, so that codegen reads the cached result instead of re-inferring it.
+ */
+typedef struct Lowerer
+{
+    ParserContext *pctx; ///< Reference to global parser context (for lookups).
+    int typed_count;     ///< Expressions carrying a resolved type after lowering.
+    int deferred_count;  ///< Expressions left for scope-dependent inference in codegen.
+} Lowerer;
+
+/**
+ * @brief Main Lowering Entry Point.
+ *
+ * Turns the parsed AST into the typed form consumed by codegen: every
+ * expression whose type is known gets both `type_info` and `resolved_type`
+ * set. Later optimization passes hang off this entry point.
+ *
+ * @param ctx Global parser context.
+ * @param root Root AST node of the program.
+ */
+void lower_program(ParserContext *ctx, ASTNode *root);
+
+#endif // LOWER_H
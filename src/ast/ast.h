@@ -228,6 +228,7 @@ struct ASTNode
             int unused;      // @unused
             int weak;        // @weak
             int is_export;   // @export (visibility default).
+            int is_internal; // Monomorphized copy, emitted `static`.
             int cold;        // @cold
             int hot;         // @hot
             int noreturn;    // @noreturn
@@ -508,6 +509,7 @@ struct ASTNode
         {
             char *name;
             ASTNode *body;
+            int is_bench; // `bench "name" { }` block, only emitted by `zc bench`.
         } test_stmt;
 
         struct
@@ -541,14 +541,22 @@ void codegen_expression(ParserContext *ctx, ASTNode *node, FILE *out)
                         StructRef *ref = ctx->parsed_impls_list;
                         while (ref)
                         {
-                            if (ref->node && ref->node->type == NODE_IMPL_TRAIT &&
-                                strcmp(ref->node->impl_trait.target_type, base) == 0)
+                            // Generic instantiation spells primitives by their C name
+                            // (`int32_t`), while the impl keeps the Zen name (`int`).
+                            char *impl_target =
+                                (ref->node && ref->node->type == NODE_IMPL_TRAIT)
+                                    ? ref->node->impl_trait.target_type
+                                    : NULL;
+                            if (impl_target &&
+                                (strcmp(impl_target, base) == 0 ||
+                                 strcmp(normalize_type_name(impl_target), base) == 0))
                             {
                                 char trait_mangled[256];
-                                snprintf(trait_mangled, sizeof(trait_mangled), "%s__%s_%s", base,
-                                         ref->node->impl_trait.trait_name, method);
+                                snprintf(trait_mangled, sizeof(trait_mangled), "%s__%s_%s",
+                                         impl_target, ref->node->impl_trait.trait_name, method);
                                 if (find_func(ctx, trait_mangled))
                                 {
+                                    call_base = impl_target;
                                     size_t suffix_len = strlen(ref->node->impl_trait.trait_name) +
                                                         strlen(method) + 2;
                                     char *suffix = xmalloc(suffix_len);
@@ -751,6 +759,8 @@ void codegen_expression(ParserContext *ctx, ASTNode *node, FILE *out)
 
                     // Skip internal runtime functions
                     int is_internal = strncmp(name, "_z_", 3) == 0 || strncmp(name, "_Z", 2) == 0;
+                    // black_box() is defined by the preamble in programs with benches.
+                    is_internal |= ctx->has_bench && strcmp(name, "black_box") == 0;
 
                     // Only warn if no C interop and not an internal function
                     if (!has_c_interop && !is_internal)
@@ -1225,6 +1235,20 @@ void codegen_expression(ParserContext *ctx, ASTNode *node, FILE *out)
     case NODE_EXPR_UNARY:
         if (node->unary.op && strcmp(node->unary.op, "&_rval") == 0)
         {
+            // A compound literal lives until the end of the enclosing block, so
+            // the pointer stays valid for the whole call it is passed to. The
+            // statement-expression form below is the fallback for operands
+            // whose type cannot be spelled, and for C++, which has no compound
+            // literals.
+            char *rt = g_config.use_cpp ? NULL : infer_type(ctx, node->unary.operand);
+            if (rt && strcmp(rt, "__auto_type") != 0 && strcmp(rt, "unknown") != 0 &&
+                !strchr(rt, '['))
+            {
+                fprintf(out, "(&((struct { %s v; }){ (", rt);
+                codegen_expression(ctx, node->unary.operand, out);
+                fprintf(out, ") }).v)");
+                break;
+            }
             fprintf(out, "({ ");
             emit_auto_type(ctx, node->unary.operand, node->token, out);
             fprintf(out, " _t = (");
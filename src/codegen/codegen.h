@@ -65,7 +65,6 @@ void emit_struct_defs(ParserContext *ctx, ASTNode *node, FILE *out);
 void emit_trait_defs(ASTNode *node, FILE *out);
 void emit_enum_protos(ASTNode *node, FILE *out);
 void emit_globals(ParserContext *ctx, ASTNode *node, FILE *out);
-void emit_lambda_defs(ParserContext *ctx, FILE *out);
 void emit_protos(ParserContext *ctx, ASTNode *node, FILE *out);
 void emit_impl_vtables(ParserContext *ctx, FILE *out);
 
@@ -73,7 +72,59 @@ void emit_impl_vtables(ParserContext *ctx, FILE *out);
  * @brief Emits test runner and test cases if testing is enabled.
  */
 int emit_tests_and_runner(ParserContext *ctx, ASTNode *node, FILE *out);
+
+/**
+ * @brief Emits bench functions and the `_z_run_benches` runtime (`zc bench` only).
+ */
+int emit_benches_and_runner(ParserContext *ctx, ASTNode *node, FILE *out);
 void print_type_defs(ParserContext *ctx, FILE *out, ASTNode *nodes);
+void emit_lambda_def(ParserContext *ctx, ASTNode *node, FILE *out);
+void emit_drop_glue(const char *tname, FILE *out);
+
+// Reachability pruning (codegen_reach.c).
+
+/**
+ * @brief Kind of an emission unit tracked by the reachability pass.
+ */
+typedef enum
+{
+    REACH_ROOT,   ///< Always emitted; its references are followed.
+    REACH_FUNC,   ///< Function body; emitted only if referenced from live code.
+    REACH_PROTOS, ///< Prototype block; lines naming pruned functions are dropped.
+    REACH_DECLS   ///< One definition per line (vtables); each line pruned on its own.
+} ReachKind;
+
+typedef struct Reach Reach;
+
+/**
+ * @brief Starts collecting emission units for a program.
+ *
+ * Returns NULL (and every other reach_* call becomes a no-op) when the program
+ * has no entry point or is built as an object/shared library, since then any
+ * symbol may be referenced from outside.
+ */
+Reach *reach_begin(ParserContext *ctx, ASTNode *kids);
+
+/**
+ * @brief Stream to emit into: the scratch buffer while collecting, else `out`.
+ */
+FILE *reach_stream(Reach *r, FILE *out);
+
+/**
+ * @brief Ends the current unit and starts a new one at the current position.
+ */
+void reach_unit(Reach *r, ReachKind kind, const char *name);
+
+/**
+ * @brief Returns 1 if the function must be kept regardless of references
+ * (`main`, `@export`, `@constructor`, ...).
+ */
+int reach_is_entry(ASTNode *fn);
+
+/**
+ * @brief Resolves reachability from the root units and writes the live units to `out`.
+ */
+void reach_finish(Reach *r, FILE *out);
 
 // Global state (shared across modules).
 extern ASTNode *global_user_structs;  ///< List of user defined structs.
@@ -101,6 +101,25 @@ void emit_preamble(ParserContext *ctx, FILE *out)
         }
 
         fputs("typedef size_t usize;\ntypedef char* string;\n", out);
+        if (ctx->has_bench)
+        {
+            // black_box(x): yields x while hiding it from the optimizer, so
+            // benchmarked work is neither folded nor discarded.
+            if (g_config.use_cpp)
+            {
+                fputs("template<typename T> inline T black_box(T x) { __asm__ __volatile__(\"\" "
+                      ": : \"g\"(&x) : \"memory\"); return x; }\n",
+                      out);
+            }
+            else
+            {
+                fputs("#if defined(__GNUC__) || defined(__clang__)\n", out);
+                fputs("#define black_box(x) ({ ZC_AUTO _z_bb = (x); __asm__ __volatile__(\"\" : : "
+                      "\"g\"(&_z_bb) : \"memory\"); _z_bb; })\n",
+                      out);
+                fputs("#else\n#define black_box(x) (x)\n#endif\n", out);
+            }
+        }
         if (ctx->has_async)
         {
             fputs("#include <pthread.h>\n", out);
@@ -278,57 +297,52 @@ void emit_enum_protos(ASTNode *node, FILE *out)
 }
 
 // Emit lambda definitions.
-void emit_lambda_defs(ParserContext *ctx, FILE *out)
+void emit_lambda_def(ParserContext *ctx, ASTNode *node, FILE *out)
 {
-    LambdaRef *cur = ctx->global_lambdas;
-    while (cur)
-    {
-        ASTNode *node = cur->node;
-        int saved_defer = defer_count;
-        defer_count = 0;
+    int saved_defer = defer_count;
+    defer_count = 0;
 
-        if (node->lambda.num_captures > 0)
+    if (node->lambda.num_captures > 0)
+    {
+        fprintf(out, "struct Lambda_%d_Ctx {\n", node->lambda.lambda_id);
+        for (int i = 0; i < node->lambda.num_captures; i++)
         {
-            fprintf(out, "struct Lambda_%d_Ctx {\n", node->lambda.lambda_id);
-            for (int i = 0; i < node->lambda.num_captures; i++)
-            {
-                fprintf(out, "    %s %s;\n", node->lambda.captured_types[i],
-                        node->lambda.captured_vars[i]);
-            }
-            fprintf(out, "};\n");
+            fprintf(out, "    %s %s;\n", node->lambda.captured_types[i],
+                    node->lambda.captured_vars[i]);
         }
+        fprintf(out, "};\n");
+    }
 
-        fprintf(out, "%s _lambda_%d(void* _ctx", node->lambda.return_type, node->lambda.lambda_id);
+    fprintf(out, "static %s _lambda_%d(void* _ctx", node->lambda.return_type,
+            node->lambda.lambda_id);
 
-        for (int i = 0; i < node->lambda.num_params; i++)
-        {
-            fprintf(out, ", %s %s", node->lambda.param_types[i], node->lambda.param_names[i]);
-        }
-        fprintf(out, ") {\n");
+    for (int i = 0; i < node->lambda.num_params; i++)
+    {
+        fprintf(out, ", %s %s", node->lambda.param_types[i], node->lambda.param_names[i]);
+    }
+    fprintf(out, ") {\n");
 
-        if (node->lambda.num_captures > 0)
-        {
-            fprintf(out, "    struct Lambda_%d_Ctx* ctx = (struct Lambda_%d_Ctx*)_ctx;\n",
-                    node->lambda.lambda_id, node->lambda.lambda_id);
-        }
+    if (node->lambda.num_captures > 0)
+    {
+        fprintf(out, "    struct Lambda_%d_Ctx* ctx = (struct Lambda_%d_Ctx*)_ctx;\n",
+                node->lambda.lambda_id, node->lambda.lambda_id);
+    }
 
-        g_current_lambda = node;
-        if (node->lambda.body && node->lambda.body->type == NODE_BLOCK)
-        {
-            codegen_walker(ctx, node->lambda.body->block.statements, out);
-        }
-        g_current_lambda = NULL;
+    g_current_lambda = node;
+    if (node->lambda.body && node->lambda.body->type == NODE_BLOCK)
+    {
+        codegen_walker(ctx, node->lambda.body->block.statements, out);
+    }
+    g_current_lambda = NULL;
 
-        for (int i = defer_count - 1; i >= 0; i--)
-        {
-            codegen_node_single(ctx, defer_stack[i], out);
-        }
+    for (int i = defer_count - 1; i >= 0; i--)
+    {
+        codegen_node_single(ctx, defer_stack[i], out);
+    }
 
-        fprintf(out, "}\n\n");
+    fprintf(out, "}\n\n");
 
-        defer_count = saved_defer;
-        cur = cur->next;
-    }
+    defer_count = saved_defer;
 }
 
 // Emit struct and enum definitions.
@@ -496,6 +510,19 @@ static char *substitute_proto_self(const char *type_str, const char *replacement
     return xstrdup(type_str);
 }
 
+// Forwards the arguments after `self` from a trait wrapper to its vtable slot.
+// A `Self*` argument is itself a trait object, so the slot gets the object it wraps.
+static void emit_trait_forward_args(ASTNode *m, FILE *out)
+{
+    for (int i = 1; i < m->func.arg_count && m->func.param_names; i++)
+    {
+        Type *t = m->func.arg_types ? m->func.arg_types[i] : NULL;
+        int is_self_ptr = t && t->kind == TYPE_POINTER && t->inner && t->inner->name &&
+                          strcmp(t->inner->name, "Self") == 0;
+        fprintf(out, is_self_ptr ? ", %s->self" : ", %s", m->func.param_names[i]);
+    }
+}
+
 // Emit trait definitions.
 void emit_trait_defs(ASTNode *node, FILE *out)
 {
@@ -541,7 +568,8 @@ void emit_trait_defs(ASTNode *node, FILE *out)
                             strncpy(new_s, args_safe, off);
                             new_s[off] = 0;
                             strcat(new_s, "void*");
-                            strcat(new_s, p + 4);
+                            // `Self*` is an erased object pointer too, not `void**`.
+                            strcat(new_s, p + 4 + (p[4] == '*'));
                             free(args_safe);
                             args_safe = new_s;
                             p = strstr(args_safe + off + 5, "Self");
@@ -624,11 +652,7 @@ void emit_trait_defs(ASTNode *node, FILE *out)
                     char *call_args = extract_call_args(m->func.args);
                     if (has_self)
                     {
-                        char *comma = strchr(call_args, ',');
-                        if (comma)
-                        {
-                            fprintf(out, ", %s", comma + 1);
-                        }
+                        emit_trait_forward_args(m, out);
                     }
                     else
                     {
@@ -868,13 +892,15 @@ void emit_protos(ParserContext *ctx, ASTNode *node, FILE *out)
                     m = m->next;
                     continue;
                 }
+                const char *linkage = m->func.is_internal ? "static " : "";
                 if (m->func.is_async)
                 {
-                    fprintf(out, "Async %s(%s);\n", m->func.name, m->func.args);
+                    fprintf(out, "%sAsync %s(%s);\n", linkage, m->func.name, m->func.args);
                 }
                 else
                 {
-                    fprintf(out, "%s %s(%s);\n", m->func.ret_type, m->func.name, m->func.args);
+                    fprintf(out, "%s%s %s(%s);\n", linkage, m->func.ret_type, m->func.name,
+                            m->func.args);
                 }
                 m = m->next;
             }
@@ -1036,7 +1062,7 @@ int emit_tests_and_runner(ParserContext *ctx, ASTNode *node, FILE *out)
     int test_count = 0;
     while (cur)
     {
-        if (cur->type == NODE_TEST)
+        if (cur->type == NODE_TEST && !cur->test_stmt.is_bench)
         {
             fprintf(out, "static void _z_test_%d() {\n", test_count);
             int saved = defer_count;
@@ -1064,6 +1090,151 @@ int emit_tests_and_runner(ParserContext *ctx, ASTNode *node, FILE *out)
     return test_count;
 }
 
+// Runtime for `zc bench`. Each case is calibrated by doubling its batch size
+// until one batch runs for at least 1ms, warmed up for a tenth of the time
+// budget, then sampled batch by batch on the monotonic clock.
+static const char *ZC_BENCH_RUNTIME =
+    "#include <time.h>\n"
+    "typedef struct { const char *name; void (*fn)(uint64_t); } _z_bench_case;\n"
+    "static uint64_t _z_bench_now(void) {\n"
+    "    struct timespec ts;\n"
+    "#if defined(_WIN32)\n"
+    "    timespec_get(&ts, TIME_UTC);\n"
+    "#else\n"
+    "    clock_gettime(CLOCK_MONOTONIC, &ts);\n"
+    "#endif\n"
+    "    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;\n"
+    "}\n"
+    "static int _z_bench_cmp(const void *a, const void *b) {\n"
+    "    double x = *(const double *)a, y = *(const double *)b;\n"
+    "    return (x > y) - (x < y);\n"
+    "}\n"
+    "static void _z_bench_fmt(char *buf, size_t n, double ns) {\n"
+    "    if (ns < 1e3) snprintf(buf, n, \"%.2f ns\", ns);\n"
+    "    else if (ns < 1e6) snprintf(buf, n, \"%.2f us\", ns / 1e3);\n"
+    "    else if (ns < 1e9) snprintf(buf, n, \"%.2f ms\", ns / 1e6);\n"
+    "    else snprintf(buf, n, \"%.2f s\", ns / 1e9);\n"
+    "}\n"
+    "static void _z_bench_json_str(FILE *f, const char *s) {\n"
+    "    fputc('\"', f);\n"
+    "    for (; *s; s++) { if (*s == '\"' || *s == '\\\\') fputc('\\\\', f); fputc(*s, f); }\n"
+    "    fputc('\"', f);\n"
+    "}\n"
+    "static int _z_run_benches(int argc, char **argv, const _z_bench_case *cases, int count) {\n"
+    "    const char *filter = NULL, *json = NULL;\n"
+    "    double budget_ms = 1000;\n"
+    "    for (int i = 1; i < argc; i++) {\n"
+    "        if (strcmp(argv[i], \"--filter\") == 0 && i + 1 < argc) filter = argv[++i];\n"
+    "        else if (strcmp(argv[i], \"--json\") == 0 && i + 1 < argc) json = argv[++i];\n"
+    "        else if (strcmp(argv[i], \"--time\") == 0 && i + 1 < argc) budget_ms = "
+    "atof(argv[++i]);\n"
+    "    }\n"
+    "    if (budget_ms <= 0) budget_ms = 1000;\n"
+    "    uint64_t budget = (uint64_t)(budget_ms * 1e6), warmup = budget / 10;\n"
+    "    FILE *jf = NULL;\n"
+    "    if (json) {\n"
+    "        jf = fopen(json, \"w\");\n"
+    "        if (!jf) { fprintf(stderr, \"bench: cannot open %s\\n\", json); return 1; }\n"
+    "        fputs(\"[\", jf);\n"
+    "    }\n"
+    "    double *samples = (double *)malloc(sizeof(double) * 1000);\n"
+    "    int ran = 0;\n"
+    "    printf(\"%-32s %12s %12s %12s %12s %16s\\n\", \"bench\", \"mean\", \"median\", \"p99\", "
+    "\"min\", \"samples x iters\");\n"
+    "    for (int c = 0; c < count; c++) {\n"
+    "        if (filter && !strstr(cases[c].name, filter)) continue;\n"
+    "        uint64_t iters = 1, start = _z_bench_now();\n"
+    "        for (;;) {\n"
+    "            uint64_t t0 = _z_bench_now();\n"
+    "            cases[c].fn(iters);\n"
+    "            if (_z_bench_now() - t0 >= 1000000 || iters >= (1ull << 40)) break;\n"
+    "            iters *= 2;\n"
+    "        }\n"
+    "        while (_z_bench_now() - start < warmup) cases[c].fn(iters);\n"
+    "        int n = 0;\n"
+    "        uint64_t sample_start = _z_bench_now();\n"
+    "        do {\n"
+    "            uint64_t t0 = _z_bench_now();\n"
+    "            cases[c].fn(iters);\n"
+    "            samples[n++] = (double)(_z_bench_now() - t0) / (double)iters;\n"
+    "        } while (n < 1000 && (n < 10 || _z_bench_now() - sample_start < budget));\n"
+    "        qsort(samples, n, sizeof(double), _z_bench_cmp);\n"
+    "        double sum = 0;\n"
+    "        for (int i = 0; i < n; i++) sum += samples[i];\n"
+    "        double mean = sum / n;\n"
+    "        double median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;\n"
+    "        double p99 = samples[(99 * n + 99) / 100 - 1];\n"
+    "        char b0[32], b1[32], b2[32], b3[32], b4[48];\n"
+    "        _z_bench_fmt(b0, sizeof(b0), mean);\n"
+    "        _z_bench_fmt(b1, sizeof(b1), median);\n"
+    "        _z_bench_fmt(b2, sizeof(b2), p99);\n"
+    "        _z_bench_fmt(b3, sizeof(b3), samples[0]);\n"
+    "        snprintf(b4, sizeof(b4), \"%d x %llu\", n, (unsigned long long)iters);\n"
+    "        printf(\"%-32s %12s %12s %12s %12s %16s\\n\", cases[c].name, b0, b1, b2, b3, b4);\n"
+    "        fflush(stdout);\n"
+    "        if (jf) {\n"
+    "            fputs(ran ? \",\\n  {\\\"name\\\": \" : \"\\n  {\\\"name\\\": \", jf);\n"
+    "            _z_bench_json_str(jf, cases[c].name);\n"
+    "            fprintf(jf, \", \\\"samples\\\": %d, \\\"iterations\\\": %llu, \\\"mean_ns\\\": "
+    "%.3f, \\\"median_ns\\\": %.3f, \\\"p99_ns\\\": %.3f, \\\"min_ns\\\": %.3f}\", n, (unsigned "
+    "long long)iters, mean, median, p99, samples[0]);\n"
+    "        }\n"
+    "        ran++;\n"
+    "    }\n"
+    "    if (jf) { fputs(ran ? \"\\n]\\n\" : \"]\\n\", jf); fclose(jf); }\n"
+    "    if (!ran) printf(\"No benchmarks matched.\\n\");\n"
+    "    free(samples);\n"
+    "    return 0;\n"
+    "}\n";
+
+// Emit bench functions and the bench runtime. Returns number of benches emitted.
+int emit_benches_and_runner(ParserContext *ctx, ASTNode *node, FILE *out)
+{
+    if (g_config.is_freestanding)
+    {
+        return 0;
+    }
+    ASTNode *cur = node;
+    int bench_count = 0;
+    while (cur)
+    {
+        if (cur->type == NODE_TEST && cur->test_stmt.is_bench)
+        {
+            if (bench_count == 0)
+            {
+                fputs(ZC_BENCH_RUNTIME, out);
+            }
+            // The body runs once per iteration; defers fire at the end of each.
+            fprintf(out, "static void _z_bench_%d(uint64_t _z_iters) {\n", bench_count);
+            fprintf(out, "for (uint64_t _z_it = 0; _z_it < _z_iters; _z_it++) {\n");
+            int saved = defer_count;
+            codegen_walker(ctx, cur->test_stmt.body, out);
+            for (int i = defer_count - 1; i >= saved; i--)
+            {
+                codegen_node_single(ctx, defer_stack[i], out);
+            }
+            defer_count = saved;
+            fprintf(out, "}\n}\n");
+            bench_count++;
+        }
+        cur = cur->next;
+    }
+    if (bench_count > 0)
+    {
+        fprintf(out, "\nstatic const _z_bench_case _z_benches[] = {\n");
+        int i = 0;
+        for (cur = node; cur; cur = cur->next)
+        {
+            if (cur->type == NODE_TEST && cur->test_stmt.is_bench)
+            {
+                fprintf(out, "    {\"%s\", _z_bench_%d},\n", cur->test_stmt.name, i++);
+            }
+        }
+        fprintf(out, "};\n\n");
+    }
+    return bench_count;
+}
+
 // Emit type definitions-
 void print_type_defs(ParserContext *ctx, FILE *out, ASTNode *nodes)
 {
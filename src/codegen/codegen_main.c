@@ -295,6 +295,32 @@ static void free_emitted_list(EmittedContent *list)
     }
 }
 
+// Emits an impl block one method per unit so each method is pruned on its own.
+static void emit_impl_units(ParserContext *ctx, Reach *reach, ASTNode *impl, FILE *out)
+{
+    int is_trait = (impl->type == NODE_IMPL_TRAIT);
+    g_current_impl_type = is_trait ? impl->impl_trait.target_type : impl->impl.struct_name;
+
+    ASTNode *m = is_trait ? impl->impl_trait.methods : impl->impl.methods;
+    while (m)
+    {
+        reach_unit(reach, reach_is_entry(m) ? REACH_ROOT : REACH_FUNC,
+                   m->type == NODE_FUNCTION ? m->func.name : NULL);
+        codegen_node_single(ctx, m, out);
+        m = m->next;
+    }
+
+    if (is_trait && strcmp(impl->impl_trait.trait_name, "Drop") == 0)
+    {
+        char *glue = xmalloc(strlen(impl->impl_trait.target_type) + 16);
+        sprintf(glue, "%s__Drop_glue", impl->impl_trait.target_type);
+        reach_unit(reach, REACH_FUNC, glue);
+        emit_drop_glue(impl->impl_trait.target_type, out);
+        free(glue);
+    }
+    g_current_impl_type = NULL;
+}
+
 // Main entry point for code generation.
 void codegen_node(ParserContext *ctx, ASTNode *node, FILE *out)
 {
@@ -310,6 +336,11 @@ void codegen_node(ParserContext *ctx, ASTNode *node, FILE *out)
 
         global_user_structs = kids;
 
+        // Buffer the output per function so unreachable code can be dropped at the end.
+        Reach *reach = reach_begin(ctx, kids);
+        FILE *final_out = out;
+        out = reach_stream(reach, out);
+
         if (!ctx->skip_preamble)
         {
             emit_preamble(ctx, out);
@@ -649,13 +680,25 @@ void codegen_node(ParserContext *ctx, ASTNode *node, FILE *out)
             }
         }
 
+        reach_unit(reach, REACH_PROTOS, NULL);
         emit_protos(ctx, merged_funcs, out);
 
+        reach_unit(reach, REACH_DECLS, NULL);
         emit_impl_vtables(ctx, out);
 
-        emit_lambda_defs(ctx, out);
+        LambdaRef *lambda = ctx->global_lambdas;
+        while (lambda)
+        {
+            char lambda_name[64];
+            sprintf(lambda_name, "_lambda_%d", lambda->node->lambda.lambda_id);
+            reach_unit(reach, REACH_FUNC, lambda_name);
+            emit_lambda_def(ctx, lambda->node, out);
+            lambda = lambda->next;
+        }
 
+        reach_unit(reach, REACH_ROOT, NULL);
         int test_count = emit_tests_and_runner(ctx, kids, out);
+        int bench_count = g_config.mode_bench ? emit_benches_and_runner(ctx, kids, out) : 0;
 
         ASTNode *iter = merged_funcs;
         while (iter)
@@ -748,9 +791,19 @@ void codegen_node(ParserContext *ctx, ASTNode *node, FILE *out)
                     continue;
                 }
             }
-            codegen_node_single(ctx, iter, out);
+            if (reach && (iter->type == NODE_IMPL || iter->type == NODE_IMPL_TRAIT))
+            {
+                emit_impl_units(ctx, reach, iter, out);
+            }
+            else
+            {
+                reach_unit(reach, reach_is_entry(iter) ? REACH_ROOT : REACH_FUNC,
+                           iter->type == NODE_FUNCTION ? iter->func.name : NULL);
+                codegen_node_single(ctx, iter, out);
+            }
             iter = iter->next;
         }
+        reach_unit(reach, REACH_ROOT, NULL);
 
         int has_user_main = 0;
         ASTNode *chk = merged_funcs;
@@ -764,10 +817,24 @@ void codegen_node(ParserContext *ctx, ASTNode *node, FILE *out)
             chk = chk->next;
         }
 
-        if (!has_user_main && test_count > 0)
+        if (!has_user_main && bench_count > 0)
+        {
+            fprintf(out,
+                    "\nint main(int argc, char **argv) { return _z_run_benches(argc, argv, "
+                    "_z_benches, %d); }\n",
+                    bench_count);
+        }
+        else if (!has_user_main && test_count > 0)
         {
             fprintf(out, "\nint main() { _z_run_tests(); return 0; }\n");
         }
+        else if (!has_user_main && ctx->has_bench && !g_config.mode_bench)
+        {
+            fprintf(out, "\nint main() { printf(\"[zc] Run benchmarks with 'zc bench'.\\n\"); "
+                         "return 0; }\n");
+        }
+
+        reach_finish(reach, final_out);
 
         // Clean up emitted content tracking list
         free_emitted_list(emitted_raw);
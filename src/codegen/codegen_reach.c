@@ -0,0 +1,495 @@
+
+#include "codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Reachability pruning works on the emitted C rather than on the AST: by the
+// time a body has been generated, every implicit call (drop glue, iterator
+// protocol, operator overloads, f-string helpers, vtable slots) is spelled
+// out as a plain identifier, so a reference scan over the text is exact
+// enough to build the call graph without re-deriving codegen's name mangling.
+
+typedef struct ReachUnit
+{
+    ReachKind kind;
+    char *name;  // Symbol defined by the unit (REACH_FUNC / REACH_DECLS lines).
+    long start;  // Offset into the scratch stream.
+    long end;    // Exclusive.
+    int live;    // Emitted in the final output.
+    int scanned; // References already followed.
+} ReachUnit;
+
+struct Reach
+{
+    FILE *scratch;
+    ReachUnit *units;
+    int count;
+    int cap;
+    char *text; // Scratch contents, loaded by reach_finish().
+
+    int *buckets; // Name hash -> first unit index (+1), chained through next_same.
+    int *next_same;
+    int bucket_count;
+};
+
+static unsigned int reach_hash(const char *s, size_t len)
+{
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        h = (h ^ (unsigned char)s[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int is_ident_start(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int is_ident_char(char c)
+{
+    return is_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+// `-c` / `-shared` builds produce objects whose symbols may be used elsewhere.
+static int has_cc_flag(const char *flag)
+{
+    size_t len = strlen(flag);
+    const char *p = g_config.gcc_flags;
+    while ((p = strstr(p, flag)) != NULL)
+    {
+        if ((p == g_config.gcc_flags || p[-1] == ' ') && (p[len] == ' ' || p[len] == 0))
+        {
+            return 1;
+        }
+        p += len;
+    }
+    return 0;
+}
+
+// C sources, objects or archives named by `//> link:` / `//> cflags:` directives.
+static int has_c_input(const char *flags)
+{
+    static const char *exts[] = {".c", ".cc", ".cpp", ".cxx", ".m", ".o", ".a", ".so", NULL};
+    const char *p = flags;
+    while (*p)
+    {
+        while (*p == ' ')
+        {
+            p++;
+        }
+        const char *start = p;
+        while (*p && *p != ' ')
+        {
+            p++;
+        }
+        size_t len = p - start;
+        if (len == 0 || *start == '-')
+        {
+            continue;
+        }
+        for (int i = 0; exts[i]; i++)
+        {
+            size_t el = strlen(exts[i]);
+            if (len > el && strncmp(p - el, exts[i], el) == 0)
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void reach_push(Reach *r, ReachKind kind, const char *name, long start, long end)
+{
+    if (r->count == r->cap)
+    {
+        r->cap = r->cap ? r->cap * 2 : 256;
+        r->units = realloc(r->units, sizeof(ReachUnit) * r->cap);
+    }
+    ReachUnit *u = &r->units[r->count++];
+    u->kind = kind;
+    u->name = name ? xstrdup(name) : NULL;
+    u->start = start;
+    u->end = end;
+    u->live = (kind == REACH_ROOT || kind == REACH_PROTOS);
+    u->scanned = 0;
+}
+
+// Splits a REACH_DECLS chunk into one unit per line. A line defines the
+// identifier right before its first '=' (e.g. `Trait_VTable S_Trait_VTable = {..}`);
+// lines that do not look like a definition are kept unconditionally.
+static void reach_split_decls(Reach *r, int idx)
+{
+    long start = r->units[idx].start;
+    long end = r->units[idx].end;
+    r->units[idx].end = start; // The chunk itself becomes empty.
+
+    long line = start;
+    while (line < end)
+    {
+        long eol = line;
+        while (eol < end && r->text[eol] != '\n')
+        {
+            eol++;
+        }
+        if (eol < end)
+        {
+            eol++;
+        }
+
+        char *name = NULL;
+        char *eq = memchr(r->text + line, '=', eol - line);
+        if (eq)
+        {
+            char *p = eq;
+            while (p > r->text + line && p[-1] == ' ')
+            {
+                p--;
+            }
+            char *q = p;
+            while (q > r->text + line && is_ident_char(q[-1]))
+            {
+                q--;
+            }
+            if (q < p)
+            {
+                name = xmalloc(p - q + 1);
+                memcpy(name, q, p - q);
+                name[p - q] = 0;
+            }
+        }
+        reach_push(r, name ? REACH_DECLS : REACH_ROOT, name, line, eol);
+        line = eol;
+    }
+}
+
+static void reach_index(Reach *r)
+{
+    r->bucket_count = 1;
+    while (r->bucket_count < r->count * 2)
+    {
+        r->bucket_count <<= 1;
+    }
+    r->buckets = xmalloc(sizeof(int) * r->bucket_count);
+    memset(r->buckets, 0, sizeof(int) * r->bucket_count);
+    r->next_same = xmalloc(sizeof(int) * (r->count ? r->count : 1));
+
+    for (int i = 0; i < r->count; i++)
+    {
+        r->next_same[i] = 0;
+        if (!r->units[i].name)
+        {
+            continue;
+        }
+        unsigned int b =
+            reach_hash(r->units[i].name, strlen(r->units[i].name)) & (r->bucket_count - 1);
+        r->next_same[i] = r->buckets[b];
+        r->buckets[b] = i + 1;
+    }
+}
+
+// Returns the next unit (after index `after`, or the first if negative) whose
+// name equals s[0..len), or -1.
+static int reach_lookup(Reach *r, const char *s, size_t len, int after)
+{
+    int i;
+    if (after < 0)
+    {
+        i = r->buckets[reach_hash(s, len) & (r->bucket_count - 1)] - 1;
+    }
+    else
+    {
+        i = r->next_same[after] - 1;
+    }
+    while (i >= 0)
+    {
+        const char *n = r->units[i].name;
+        if (strncmp(n, s, len) == 0 && n[len] == 0)
+        {
+            return i;
+        }
+        i = r->next_same[i] - 1;
+    }
+    return -1;
+}
+
+// Marks every unit referenced from `idx` as live, pushing them on the worklist.
+static void reach_scan(Reach *r, int idx, int *stack, int *sp)
+{
+    const char *p = r->text + r->units[idx].start;
+    const char *end = r->text + r->units[idx].end;
+    while (p < end)
+    {
+        if (is_ident_start(*p))
+        {
+            const char *s = p;
+            while (p < end && is_ident_char(*p))
+            {
+                p++;
+            }
+            for (int i = reach_lookup(r, s, p - s, -1); i >= 0; i = reach_lookup(r, s, p - s, i))
+            {
+                if (!r->units[i].live)
+                {
+                    r->units[i].live = 1;
+                    stack[(*sp)++] = i;
+                }
+            }
+        }
+        else if (*p >= '0' && *p <= '9')
+        {
+            // Skip numeric literals so suffixes like `0x1f` are not read as names.
+            while (p < end && is_ident_char(*p))
+            {
+                p++;
+            }
+        }
+        else
+        {
+            p++;
+        }
+    }
+}
+
+// Emits a prototype chunk, dropping declarations of pruned functions.
+static void reach_write_protos(Reach *r, ReachUnit *u, FILE *out)
+{
+    long line = u->start;
+    while (line < u->end)
+    {
+        long eol = line;
+        while (eol < u->end && r->text[eol] != '\n')
+        {
+            eol++;
+        }
+        if (eol < u->end)
+        {
+            eol++;
+        }
+
+        int dead = 0;
+        const char *p = r->text + line;
+        const char *end = r->text + eol;
+        while (p < end && !dead)
+        {
+            if (is_ident_start(*p))
+            {
+                const char *s = p;
+                while (p < end && is_ident_char(*p))
+                {
+                    p++;
+                }
+                int defined = 0;
+                int live = 0;
+                for (int i = reach_lookup(r, s, p - s, -1); i >= 0;
+                     i = reach_lookup(r, s, p - s, i))
+                {
+                    defined |= (r->units[i].kind == REACH_FUNC);
+                    live |= r->units[i].live;
+                }
+                dead = defined && !live;
+            }
+            else
+            {
+                p++;
+            }
+        }
+
+        if (!dead)
+        {
+            fwrite(r->text + line, 1, eol - line, out);
+        }
+        line = eol;
+    }
+}
+
+static ReachUnit *g_reach_sort_units = NULL;
+
+static int reach_cmp_start(const void *a, const void *b)
+{
+    long sa = g_reach_sort_units[*(const int *)a].start;
+    long sb = g_reach_sort_units[*(const int *)b].start;
+    return (sa > sb) - (sa < sb);
+}
+
+// ** Public API **
+
+Reach *reach_begin(ParserContext *ctx, ASTNode *kids)
+{
+    if (g_config.repl_mode || has_cc_flag("-c") || has_cc_flag("-shared"))
+    {
+        return NULL;
+    }
+
+    // Only programs with an entry point can be pruned; libraries keep everything.
+    int has_entry = 0;
+    for (StructRef *ref = ctx->parsed_funcs_list; ref && !has_entry; ref = ref->next)
+    {
+        if (ref->node && ref->node->type == NODE_FUNCTION && ref->node->func.name &&
+            strcmp(ref->node->func.name, "main") == 0)
+        {
+            has_entry = 1;
+        }
+    }
+    for (ASTNode *k = kids; k && !has_entry; k = k->next)
+    {
+        if (k->type == NODE_TEST)
+        {
+            has_entry = 1;
+        }
+    }
+    if (!has_entry)
+    {
+        return NULL;
+    }
+
+    // Local C code may call Zen functions we cannot see, so keep everything.
+    if (has_c_input(g_link_flags) || has_c_input(g_cflags))
+    {
+        return NULL;
+    }
+    for (ASTNode *k = kids; k; k = k->next)
+    {
+        if (k->type == NODE_INCLUDE && !k->include.is_system)
+        {
+            return NULL;
+        }
+    }
+
+    FILE *scratch = tmpfile();
+    if (!scratch)
+    {
+        return NULL;
+    }
+
+    Reach *r = xmalloc(sizeof(Reach));
+    memset(r, 0, sizeof(Reach));
+    r->scratch = scratch;
+    reach_push(r, REACH_ROOT, NULL, 0, 0);
+    return r;
+}
+
+FILE *reach_stream(Reach *r, FILE *out)
+{
+    return r ? r->scratch : out;
+}
+
+void reach_unit(Reach *r, ReachKind kind, const char *name)
+{
+    if (!r)
+    {
+        return;
+    }
+    long pos = ftell(r->scratch);
+    r->units[r->count - 1].end = pos;
+    if (kind == REACH_FUNC && !name)
+    {
+        kind = REACH_ROOT;
+    }
+    reach_push(r, kind, name, pos, pos);
+}
+
+int reach_is_entry(ASTNode *fn)
+{
+    if (fn->type != NODE_FUNCTION)
+    {
+        return 1;
+    }
+    return strcmp(fn->func.name, "main") == 0 || fn->func.constructor || fn->func.destructor ||
+           fn->func.is_export || fn->func.weak || fn->func.section || fn->func.cuda_global;
+}
+
+void reach_finish(Reach *r, FILE *out)
+{
+    if (!r)
+    {
+        return;
+    }
+
+    long size = ftell(r->scratch);
+    r->units[r->count - 1].end = size;
+    r->text = xmalloc(size + 1);
+    fseek(r->scratch, 0, SEEK_SET);
+    if (fread(r->text, 1, size, r->scratch) != (size_t)size)
+    {
+        size = 0;
+    }
+    r->text[size] = 0;
+    fclose(r->scratch);
+
+    int chunk_count = r->count;
+    for (int i = 0; i < chunk_count; i++)
+    {
+        if (r->units[i].kind == REACH_DECLS && !r->units[i].name)
+        {
+            reach_split_decls(r, i);
+        }
+    }
+    reach_index(r);
+
+    // Worklist over units: roots are live from the start.
+    int *stack = xmalloc(sizeof(int) * (r->count + 1));
+    int sp = 0;
+    for (int i = 0; i < r->count; i++)
+    {
+        if (r->units[i].live && r->units[i].kind != REACH_PROTOS)
+        {
+            stack[sp++] = i;
+        }
+    }
+    while (sp > 0)
+    {
+        int i = stack[--sp];
+        if (r->units[i].scanned)
+        {
+            continue;
+        }
+        r->units[i].scanned = 1;
+        reach_scan(r, i, stack, &sp);
+    }
+
+    // Emit in the original order. Split lines were appended after every chunk,
+    // so restore the order by offset.
+    int *order = xmalloc(sizeof(int) * (r->count + 1));
+    int n = 0;
+    for (int i = 0; i < r->count; i++)
+    {
+        if (r->units[i].end > r->units[i].start)
+        {
+            order[n++] = i;
+        }
+    }
+    g_reach_sort_units = r->units;
+    qsort(order, n, sizeof(int), reach_cmp_start);
+
+    int total = 0;
+    int pruned = 0;
+    for (int k = 0; k < n; k++)
+    {
+        ReachUnit *u = &r->units[order[k]];
+        if (u->kind == REACH_FUNC || u->kind == REACH_DECLS)
+        {
+            total++;
+            if (!u->live)
+            {
+                pruned++;
+            }
+        }
+        if (u->kind == REACH_PROTOS)
+        {
+            reach_write_protos(r, u, out);
+        }
+        else if (u->live)
+        {
+            fwrite(r->text + u->start, 1, u->end - u->start, out);
+        }
+    }
+
+    if (g_config.verbose)
+    {
+        printf("[zc] Pruned %d of %d functions and vtables as unreachable.\n", pruned, total);
+    }
+}
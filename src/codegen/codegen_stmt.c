@@ -149,6 +149,797 @@ static void emit_pattern_condition(ParserContext *ctx, const char *pattern, int
     }
 }
 
+// Emits the pattern bindings and the body of a match arm. The caller provides
+// the surrounding braces (an `if` branch or a `case` block).
+static void emit_match_arm(ParserContext *ctx, ASTNode *c, int id, int is_expr, int is_option,
+                           int is_result, int has_ref_binding, FILE *out)
+{
+    if (c->match_case.binding_count > 0)
+    {
+        for (int i = 0; i < c->match_case.binding_count; i++)
+        {
+            char *bname = c->match_case.binding_names[i];
+            int is_r = c->match_case.binding_refs ? c->match_case.binding_refs[i] : 0;
+
+            if (is_option)
+            {
+                if (strstr(g_config.cc, "tcc"))
+                {
+                    if (is_r)
+                    {
+                        fprintf(out, "__typeof__(&_m_%d.val) %s = &_m_%d.val; ", id, bname, id);
+                    }
+                    else
+                    {
+                        fprintf(out, "__typeof__(_m_%d.val) %s = _m_%d.val; ", id, bname, id);
+                    }
+                }
+                else
+                {
+                    if (is_r)
+                    {
+                        fprintf(out, "ZC_AUTO %s = &_m_%d->val; ", bname, id);
+                    }
+                    else if (has_ref_binding)
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d->val; ", bname, id);
+                    }
+                    else
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d.val; ", bname, id);
+                    }
+                }
+            }
+            else if (is_result)
+            {
+                char *field = "val";
+                if (strcmp(c->match_case.pattern, "Err") == 0)
+                {
+                    field = "err";
+                }
+
+                if (strstr(g_config.cc, "tcc"))
+                {
+                    if (is_r)
+                    {
+                        fprintf(out, "__typeof__(&_m_%d->%s) %s = &_m_%d->%s; ", id, field,
+                                bname, id, field);
+                    }
+                    else
+                    {
+                        fprintf(out, "__typeof__(_m_%d->%s) %s = _m_%d->%s; ", id, field, bname,
+                                id, field);
+                    }
+                }
+                else
+                {
+                    if (is_r)
+                    {
+                        fprintf(out, "ZC_AUTO %s = &_m_%d->%s; ", bname, id, field);
+                    }
+                    else if (has_ref_binding)
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d->%s; ", bname, id, field);
+                    }
+                    else
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d.%s; ", bname, id, field);
+                    }
+                }
+            }
+            else
+            {
+                char *v = strrchr(c->match_case.pattern, '_');
+                if (v)
+                {
+                    v++;
+                }
+                else
+                {
+                    v = c->match_case.pattern;
+                }
+
+                if (c->match_case.binding_count > 1)
+                {
+                    // Tuple destructuring: data.Variant.vI
+                    if (is_r)
+                    {
+                        fprintf(out, "ZC_AUTO %s = &_m_%d->data.%s.v%d; ", bname, id, v, i);
+                    }
+                    else if (has_ref_binding)
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d->data.%s.v%d; ", bname, id, v, i);
+                    }
+                    else
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d.data.%s.v%d; ", bname, id, v, i);
+                    }
+                }
+                else
+                {
+                    // Single destructuring: data.Variant
+                    if (is_r)
+                    {
+                        fprintf(out, "ZC_AUTO %s = &_m_%d->data.%s; ", bname, id, v);
+                    }
+                    else if (has_ref_binding)
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d->data.%s; ", bname, id, v);
+                    }
+                    else
+                    {
+                        fprintf(out, "ZC_AUTO %s = _m_%d.data.%s; ", bname, id, v);
+                    }
+                }
+            }
+        }
+    }
+
+    // Check if body is a string literal (should auto-print).
+    ASTNode *body = c->match_case.body;
+    int is_string_literal =
+        (body->type == NODE_EXPR_LITERAL && body->literal.type_kind == LITERAL_STRING);
+
+    if (is_expr)
+    {
+        fprintf(out, "_r_%d = ", id);
+        if (is_string_literal)
+        {
+            codegen_node_single(ctx, body, out);
+        }
+        else
+        {
+            if (body->type == NODE_BLOCK)
+            {
+                int saved = defer_count;
+                fprintf(out, "({ ");
+                ASTNode *stmt = body->block.statements;
+                while (stmt)
+                {
+                    codegen_node_single(ctx, stmt, out);
+                    stmt = stmt->next;
+                }
+                for (int i = defer_count - 1; i >= saved; i--)
+                {
+                    codegen_node_single(ctx, defer_stack[i], out);
+                }
+                defer_count = saved;
+                fprintf(out, " })");
+            }
+            else
+            {
+                codegen_node_single(ctx, body, out);
+            }
+        }
+        fprintf(out, ";");
+    }
+    else
+    {
+        if (is_string_literal)
+        {
+            char *inner = body->literal.string_val;
+            char *code = process_printf_sugar(ctx, inner, 1, "stdout", NULL, NULL, 0);
+            fprintf(out, "%s;", code);
+            free(code);
+        }
+        else
+        {
+            codegen_node_single(ctx, body, out);
+        }
+    }
+}
+
+// A case label of a switch-lowered match: a single value or an inclusive range.
+typedef struct
+{
+    ASTNode *arm;
+    long long lo;
+    long long hi;
+    const char *text; // Char literal to print as-is, or NULL to print the value.
+} MatchLabel;
+
+// Parses an integer (decimal, hex, octal, 0b binary; optional u/l suffix) or
+// a char literal pattern.
+static int parse_match_literal(const char *p, long long *out)
+{
+    if (p[0] == '\'')
+    {
+        size_t len = strlen(p);
+        if (len == 3 && p[2] == '\'')
+        {
+            *out = (unsigned char)p[1];
+            return 1;
+        }
+        if (len == 4 && p[1] == '\\' && p[3] == '\'')
+        {
+            switch (p[2])
+            {
+            case 'n':
+                *out = '\n';
+                return 1;
+            case 't':
+                *out = '\t';
+                return 1;
+            case 'r':
+                *out = '\r';
+                return 1;
+            case '0':
+                *out = 0;
+                return 1;
+            case '\\':
+            case '\'':
+            case '"':
+                *out = p[2];
+                return 1;
+            default:
+                return 0;
+            }
+        }
+        return 0;
+    }
+
+    if (!isdigit((unsigned char)p[0]))
+    {
+        return 0;
+    }
+    char *end = NULL;
+    if (p[0] == '0' && (p[1] == 'b' || p[1] == 'B'))
+    {
+        *out = (long long)strtoull(p + 2, &end, 2);
+    }
+    else
+    {
+        *out = (long long)strtoull(p, &end, 0);
+    }
+    while (*end == 'u' || *end == 'U' || *end == 'l' || *end == 'L')
+    {
+        end++;
+    }
+    return *end == 0;
+}
+
+// Parses one alternative of an integer pattern into an inclusive [lo, hi] label.
+static int parse_match_label(const char *part, MatchLabel *label)
+{
+    const char *range = strstr(part, "..");
+    label->text = NULL;
+    if (!range)
+    {
+        if (!parse_match_literal(part, &label->lo))
+        {
+            return 0;
+        }
+        label->hi = label->lo;
+        if (part[0] == '\'')
+        {
+            label->text = part;
+        }
+        return 1;
+    }
+
+    int inclusive = (range[2] == '=');
+    char *start = xmalloc(range - part + 1);
+    strncpy(start, part, range - part);
+    start[range - part] = 0;
+    int ok = parse_match_literal(start, &label->lo) &&
+             parse_match_literal(range + (inclusive ? 3 : 2), &label->hi);
+    free(start);
+    if (ok && !inclusive)
+    {
+        label->hi--;
+    }
+    return ok;
+}
+
+// An unlabeled `break` inside an arm targets the enclosing loop, which a C
+// `switch` would capture. Nested loops and lambdas own their breaks (only
+// their headers are scanned). Node types not listed here, raw C included,
+// count as breaking so the arm keeps the if-chain.
+static int match_arm_has_break(ASTNode *node)
+{
+    for (; node; node = node->next)
+    {
+        int hit = 0;
+        switch (node->type)
+        {
+        case NODE_BREAK:
+            hit = !node->break_stmt.target_label;
+            break;
+        case NODE_CONTINUE:
+        case NODE_EXPR_LITERAL:
+        case NODE_EXPR_VAR:
+        case NODE_EXPR_SIZEOF:
+        case NODE_LAMBDA:
+        case NODE_COMMENT:
+        case NODE_LABEL:
+        case NODE_GOTO:
+        case NODE_REFLECTION:
+            break;
+        case NODE_WHILE:
+            hit = match_arm_has_break(node->while_stmt.condition);
+            break;
+        case NODE_DO_WHILE:
+            hit = match_arm_has_break(node->do_while_stmt.condition);
+            break;
+        case NODE_FOR:
+            hit = match_arm_has_break(node->for_stmt.init) ||
+                  match_arm_has_break(node->for_stmt.condition) ||
+                  match_arm_has_break(node->for_stmt.step);
+            break;
+        case NODE_FOR_RANGE:
+            hit = match_arm_has_break(node->for_range.start) ||
+                  match_arm_has_break(node->for_range.end);
+            break;
+        case NODE_LOOP:
+        case NODE_REPEAT:
+            break;
+        case NODE_BLOCK:
+            hit = match_arm_has_break(node->block.statements);
+            break;
+        case NODE_IF:
+            hit = match_arm_has_break(node->if_stmt.condition) ||
+                  match_arm_has_break(node->if_stmt.then_body) ||
+                  match_arm_has_break(node->if_stmt.else_body);
+            break;
+        case NODE_UNLESS:
+            hit = match_arm_has_break(node->unless_stmt.condition) ||
+                  match_arm_has_break(node->unless_stmt.body);
+            break;
+        case NODE_GUARD:
+            hit = match_arm_has_break(node->guard_stmt.condition) ||
+                  match_arm_has_break(node->guard_stmt.body);
+            break;
+        case NODE_MATCH:
+            hit = match_arm_has_break(node->match_stmt.expr);
+            for (ASTNode *c = node->match_stmt.cases; c && !hit; c = c->next)
+            {
+                hit = match_arm_has_break(c->match_case.guard) ||
+                      match_arm_has_break(c->match_case.body);
+            }
+            break;
+        case NODE_VAR_DECL:
+            hit = match_arm_has_break(node->var_decl.init_expr);
+            break;
+        case NODE_DESTRUCT_VAR:
+            hit = match_arm_has_break(node->destruct.init_expr) ||
+                  match_arm_has_break(node->destruct.else_block);
+            break;
+        case NODE_DEFER:
+            hit = match_arm_has_break(node->defer_stmt.stmt);
+            break;
+        case NODE_RETURN:
+            hit = match_arm_has_break(node->ret.value);
+            break;
+        case NODE_ASSERT:
+            hit = match_arm_has_break(node->assert_stmt.condition);
+            break;
+        case NODE_REPL_PRINT:
+            hit = match_arm_has_break(node->repl_print.expr);
+            break;
+        case NODE_TRY:
+            hit = match_arm_has_break(node->try_stmt.expr);
+            break;
+        case NODE_EXPR_BINARY:
+            hit = match_arm_has_break(node->binary.left) ||
+                  match_arm_has_break(node->binary.right);
+            break;
+        case NODE_EXPR_UNARY:
+            hit = match_arm_has_break(node->unary.operand);
+            break;
+        case NODE_EXPR_CALL:
+            hit = match_arm_has_break(node->call.callee) ||
+                  match_arm_has_break(node->call.args);
+            break;
+        case NODE_EXPR_MEMBER:
+            hit = match_arm_has_break(node->member.target);
+            break;
+        case NODE_EXPR_INDEX:
+            hit = match_arm_has_break(node->index.array) ||
+                  match_arm_has_break(node->index.index);
+            break;
+        case NODE_EXPR_CAST:
+            hit = match_arm_has_break(node->cast.expr);
+            break;
+        case NODE_EXPR_STRUCT_INIT:
+            hit = match_arm_has_break(node->struct_init.fields);
+            break;
+        case NODE_EXPR_ARRAY_LITERAL:
+            hit = match_arm_has_break(node->array_literal.elements);
+            break;
+        case NODE_TERNARY:
+            hit = match_arm_has_break(node->ternary.cond) ||
+                  match_arm_has_break(node->ternary.true_expr) ||
+                  match_arm_has_break(node->ternary.false_expr);
+            break;
+        default:
+            hit = 1;
+            break;
+        }
+        if (hit)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Lowers a match over integer literals, char literals, ranges or enum tags to a
+// C `switch` so the C compiler can build a jump table. Ranges use the GNU
+// `case lo ... hi:` extension (gcc, clang, tcc). Returns 0 without emitting
+// anything if the match needs the generic if-chain (guards, string or mixed
+// patterns, overlapping values, non-integer scrutinee).
+static int emit_match_switch(ParserContext *ctx, ASTNode *node, int id, int is_expr,
+                             int is_option, int is_result, int has_ref_binding,
+                             const char *expr_type, FILE *out)
+{
+    if (is_option || is_result)
+    {
+        return 0;
+    }
+
+    int cap = 16;
+    int count = 0;
+    MatchLabel *labels = xmalloc(sizeof(MatchLabel) * cap);
+    ASTNode *default_arm = NULL;
+    int arm_count = 0;
+    int is_enum = -1;
+    char *pattern_copy = NULL;
+
+    for (ASTNode *c = node->match_stmt.cases; c && !default_arm; c = c->next)
+    {
+        if (c->match_case.guard || match_arm_has_break(c->match_case.body))
+        {
+            goto decline;
+        }
+        if (strcmp(c->match_case.pattern, "_") == 0)
+        {
+            default_arm = c;
+            continue;
+        }
+        arm_count++;
+
+        pattern_copy = xstrdup(c->match_case.pattern);
+        char *saveptr;
+        for (char *part = strtok_r(pattern_copy, "|", &saveptr); part;
+             part = strtok_r(NULL, "|", &saveptr))
+        {
+            MatchLabel label;
+            EnumVariantReg *reg = find_enum_variant(ctx, part);
+            int part_is_enum = (reg != NULL);
+            if (reg)
+            {
+                label.lo = label.hi = reg->tag_id;
+                label.text = NULL;
+            }
+            else if (c->match_case.binding_count > 0 || !parse_match_label(part, &label))
+            {
+                goto decline;
+            }
+            if (is_enum >= 0 && is_enum != part_is_enum)
+            {
+                goto decline;
+            }
+            is_enum = part_is_enum;
+
+            if (label.hi < label.lo)
+            {
+                continue; // Empty range.
+            }
+            for (int i = 0; i < count; i++)
+            {
+                if (label.lo <= labels[i].hi && labels[i].lo <= label.hi)
+                {
+                    goto decline; // First-match-wins overlap: keep the if-chain.
+                }
+            }
+            if (count == cap)
+            {
+                cap *= 2;
+                labels = realloc(labels, sizeof(MatchLabel) * cap);
+            }
+            label.arm = c;
+            labels[count++] = label;
+        }
+        free(pattern_copy);
+        pattern_copy = NULL;
+    }
+
+    if (arm_count < 2 || count == 0)
+    {
+        goto decline;
+    }
+    if (!is_enum)
+    {
+        Type *t = node->match_stmt.expr->type_info;
+        if (!is_integer_type(t) && !(expr_type && is_integer_type(type_from_string_helper(expr_type))))
+        {
+            goto decline;
+        }
+    }
+
+    if (is_enum)
+    {
+        fprintf(out, has_ref_binding ? "switch (_m_%d->tag) { " : "switch (_m_%d.tag) { ", id);
+    }
+    else
+    {
+        fprintf(out, has_ref_binding ? "switch (*_m_%d) { " : "switch (_m_%d) { ", id);
+    }
+
+    for (ASTNode *c = node->match_stmt.cases; c && c != default_arm; c = c->next)
+    {
+        int has_label = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (labels[i].arm != c)
+            {
+                continue;
+            }
+            if (labels[i].text)
+            {
+                fprintf(out, "case %s: ", labels[i].text);
+            }
+            else if (labels[i].lo == labels[i].hi)
+            {
+                fprintf(out, "case %lld: ", labels[i].lo);
+            }
+            else
+            {
+                fprintf(out, "case %lld ... %lld: ", labels[i].lo, labels[i].hi);
+            }
+            has_label = 1;
+        }
+        if (has_label)
+        {
+            fprintf(out, "{ ");
+            emit_match_arm(ctx, c, id, is_expr, is_option, is_result, has_ref_binding, out);
+            fprintf(out, " } break; ");
+        }
+    }
+    if (default_arm)
+    {
+        fprintf(out, "default: { ");
+        emit_match_arm(ctx, default_arm, id, is_expr, is_option, is_result, has_ref_binding, out);
+        fprintf(out, " } break; ");
+    }
+    fprintf(out, "}");
+    free(labels);
+    return 1;
+
+decline:
+    free(pattern_copy);
+    free(labels);
+    return 0;
+}
+
+// A string literal pattern of a dispatch-lowered match.
+typedef struct
+{
+    int arm;       // Index of the arm in emission order.
+    int seq;       // Position in the source, to keep first-match-wins order.
+    const char *text;
+    size_t len;    // Decoded byte length.
+    unsigned char first;
+} StrLabel;
+
+// Decodes the byte length and first byte of a C string literal. Returns 0 for
+// escapes we do not model (octal, \u, embedded NUL).
+static int decode_str_pattern(const char *pat, size_t *len, unsigned char *first)
+{
+    size_t n = strlen(pat);
+    if (n < 2 || pat[0] != '"' || pat[n - 1] != '"')
+    {
+        return 0;
+    }
+    size_t count = 0;
+    for (size_t i = 1; i < n - 1; i++)
+    {
+        unsigned char c = (unsigned char)pat[i];
+        if (c == '\\')
+        {
+            i++;
+            switch (pat[i])
+            {
+            case 'n':
+                c = '\n';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case '\\':
+            case '"':
+            case '\'':
+                c = (unsigned char)pat[i];
+                break;
+            case 'x':
+            {
+                if (!isxdigit((unsigned char)pat[i + 1]) || !isxdigit((unsigned char)pat[i + 2]))
+                {
+                    return 0;
+                }
+                char hex[3] = {pat[i + 1], pat[i + 2], 0};
+                c = (unsigned char)strtol(hex, NULL, 16);
+                if (c == 0 || isxdigit((unsigned char)pat[i + 3]))
+                {
+                    return 0;
+                }
+                i += 2;
+                break;
+            }
+            default:
+                return 0;
+            }
+        }
+        if (count == 0)
+        {
+            *first = c;
+        }
+        count++;
+    }
+    *len = count;
+    return 1;
+}
+
+static int str_label_cmp(const void *a, const void *b)
+{
+    const StrLabel *x = a;
+    const StrLabel *y = b;
+    if (x->len != y->len)
+    {
+        return x->len < y->len ? -1 : 1;
+    }
+    if (x->first != y->first)
+    {
+        return x->first < y->first ? -1 : 1;
+    }
+    return x->seq - y->seq;
+}
+
+// Lowers a match over string literals to a dispatch on the length, then on the
+// first byte, then a single memcmp per candidate. The matching arm index is
+// computed first and a second switch runs the arm. Returns 0 without emitting
+// anything if the match needs the generic strcmp chain.
+static int emit_match_strings(ParserContext *ctx, ASTNode *node, int id, int is_expr,
+                              int is_option, int is_result, int has_ref_binding, FILE *out)
+{
+    if (is_option || is_result || has_ref_binding)
+    {
+        return 0;
+    }
+
+    int cap = 16;
+    int count = 0;
+    StrLabel *labels = xmalloc(sizeof(StrLabel) * cap);
+    ASTNode *default_arm = NULL;
+    int arm_count = 0;
+    int result = 0;
+    char *pattern_copy = NULL;
+
+    for (ASTNode *c = node->match_stmt.cases; c && !default_arm; c = c->next)
+    {
+        if (c->match_case.guard || c->match_case.binding_count > 0 ||
+            match_arm_has_break(c->match_case.body))
+        {
+            goto done;
+        }
+        if (strcmp(c->match_case.pattern, "_") == 0)
+        {
+            default_arm = c;
+            continue;
+        }
+
+        pattern_copy = xstrdup(c->match_case.pattern);
+        char *saveptr;
+        for (char *part = strtok_r(pattern_copy, "|", &saveptr); part;
+             part = strtok_r(NULL, "|", &saveptr))
+        {
+            StrLabel label;
+            if (!decode_str_pattern(part, &label.len, &label.first))
+            {
+                goto done;
+            }
+            int dup = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (strcmp(labels[i].text, part) == 0)
+                {
+                    dup = 1; // An earlier arm already claims this string.
+                    break;
+                }
+            }
+            if (dup)
+            {
+                continue;
+            }
+            if (count == cap)
+            {
+                cap *= 2;
+                labels = realloc(labels, sizeof(StrLabel) * cap);
+            }
+            label.arm = arm_count;
+            label.seq = count;
+            label.text = xstrdup(part);
+            labels[count++] = label;
+        }
+        free(pattern_copy);
+        pattern_copy = NULL;
+        arm_count++;
+    }
+
+    // A couple of strcmp calls are as cheap as the dispatch.
+    if (count < 4)
+    {
+        goto done;
+    }
+
+    qsort(labels, count, sizeof(StrLabel), str_label_cmp);
+
+    fprintf(out, "int _arm_%d = -1; size_t _len_%d = strlen(_m_%d); switch (_len_%d) { ", id, id,
+            id, id);
+    int i = 0;
+    while (i < count)
+    {
+        size_t len = labels[i].len;
+        fprintf(out, "case %zu: ", len);
+        if (len == 0)
+        {
+            fprintf(out, "_arm_%d = %d; ", id, labels[i].arm);
+            i++;
+        }
+        else
+        {
+            fprintf(out, "switch ((unsigned char)_m_%d[0]) { ", id);
+            while (i < count && labels[i].len == len)
+            {
+                unsigned char first = labels[i].first;
+                fprintf(out, "case %d: ", first);
+                int chained = 0;
+                while (i < count && labels[i].len == len && labels[i].first == first)
+                {
+                    fprintf(out, "%sif (memcmp(_m_%d, %s, %zu) == 0) { _arm_%d = %d; } ",
+                            chained ? "else " : "", id, labels[i].text, len, id, labels[i].arm);
+                    chained = 1;
+                    i++;
+                }
+                fprintf(out, "break; ");
+            }
+            fprintf(out, "} ");
+        }
+        fprintf(out, "break; ");
+    }
+    fprintf(out, "} ");
+
+    // Run the selected arm.
+    fprintf(out, "switch (_arm_%d) { ", id);
+    int arm = 0;
+    for (ASTNode *c = node->match_stmt.cases; c && c != default_arm; c = c->next, arm++)
+    {
+        fprintf(out, "case %d: { ", arm);
+        emit_match_arm(ctx, c, id, is_expr, is_option, is_result, has_ref_binding, out);
+        fprintf(out, " } break; ");
+    }
+    if (default_arm)
+    {
+        fprintf(out, "default: { ");
+        emit_match_arm(ctx, default_arm, id, is_expr, is_option, is_result, has_ref_binding, out);
+        fprintf(out, " } break; ");
+    }
+    fprintf(out, "}");
+    result = 1;
+
+done:
+    for (int k = 0; k < count; k++)
+    {
+        free((char *)labels[k].text);
+    }
+    free(pattern_copy);
+    free(labels);
+    return result;
+}
+
 void codegen_match_internal(ParserContext *ctx, ASTNode *node, FILE *out, int use_result)
 {
     int id = tmp_counter++;
@@ -274,232 +1065,64 @@ void codegen_match_internal(ParserContext *ctx, ASTNode *node, FILE *out, int us
         }
     }
 
-    ASTNode *c = node->match_stmt.cases;
-    int first = 1;
-    while (c)
+    if (!emit_match_switch(ctx, node, id, is_expr, is_option, is_result, has_ref_binding,
+                           expr_type, out) &&
+        !emit_match_strings(ctx, node, id, is_expr, is_option, is_result, has_ref_binding, out))
     {
-        if (!first)
-        {
-            fprintf(out, " else ");
-        }
-        fprintf(out, "if (");
-        if (strcmp(c->match_case.pattern, "_") == 0)
-        {
-            fprintf(out, "1");
-        }
-        else if (is_option)
-        {
-            if (strcmp(c->match_case.pattern, "Some") == 0)
-            {
-                fprintf(out, "_m_%d->is_some", id);
-            }
-            else if (strcmp(c->match_case.pattern, "None") == 0)
-            {
-                fprintf(out, "!_m_%d->is_some", id);
-            }
-            else
-            {
-                fprintf(out, "1");
-            }
-        }
-        else if (is_result)
+        ASTNode *c = node->match_stmt.cases;
+        int first = 1;
+        while (c)
         {
-            if (strcmp(c->match_case.pattern, "Ok") == 0)
-            {
-                fprintf(out, "_m_%d->is_ok", id);
-            }
-            else if (strcmp(c->match_case.pattern, "Err") == 0)
+            if (!first)
             {
-                fprintf(out, "!_m_%d->is_ok", id);
+                fprintf(out, " else ");
             }
-            else
+            fprintf(out, "if (");
+            if (strcmp(c->match_case.pattern, "_") == 0)
             {
                 fprintf(out, "1");
             }
-        }
-        else
-        {
-            // Use helper for OR patterns, range patterns, and simple patterns
-            emit_pattern_condition(ctx, c->match_case.pattern, id, has_ref_binding, out);
-        }
-        fprintf(out, ") { ");
-        if (c->match_case.binding_count > 0)
-        {
-            for (int i = 0; i < c->match_case.binding_count; i++)
+            else if (is_option)
             {
-                char *bname = c->match_case.binding_names[i];
-                int is_r = c->match_case.binding_refs ? c->match_case.binding_refs[i] : 0;
-
-                if (is_option)
+                if (strcmp(c->match_case.pattern, "Some") == 0)
                 {
-                    if (strstr(g_config.cc, "tcc"))
-                    {
-                        if (is_r)
-                        {
-                            fprintf(out, "__typeof__(&_m_%d.val) %s = &_m_%d.val; ", id, bname, id);
-                        }
-                        else
-                        {
-                            fprintf(out, "__typeof__(_m_%d.val) %s = _m_%d.val; ", id, bname, id);
-                        }
-                    }
-                    else
-                    {
-                        if (is_r)
-                        {
-                            fprintf(out, "ZC_AUTO %s = &_m_%d->val; ", bname, id);
-                        }
-                        else if (has_ref_binding)
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d->val; ", bname, id);
-                        }
-                        else
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d.val; ", bname, id);
-                        }
-                    }
+                    fprintf(out, "_m_%d->is_some", id);
                 }
-                else if (is_result)
+                else if (strcmp(c->match_case.pattern, "None") == 0)
                 {
-                    char *field = "val";
-                    if (strcmp(c->match_case.pattern, "Err") == 0)
-                    {
-                        field = "err";
-                    }
-
-                    if (strstr(g_config.cc, "tcc"))
-                    {
-                        if (is_r)
-                        {
-                            fprintf(out, "__typeof__(&_m_%d->%s) %s = &_m_%d->%s; ", id, field,
-                                    bname, id, field);
-                        }
-                        else
-                        {
-                            fprintf(out, "__typeof__(_m_%d->%s) %s = _m_%d->%s; ", id, field, bname,
-                                    id, field);
-                        }
-                    }
-                    else
-                    {
-                        if (is_r)
-                        {
-                            fprintf(out, "ZC_AUTO %s = &_m_%d->%s; ", bname, id, field);
-                        }
-                        else if (has_ref_binding)
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d->%s; ", bname, id, field);
-                        }
-                        else
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d.%s; ", bname, id, field);
-                        }
-                    }
+                    fprintf(out, "!_m_%d->is_some", id);
                 }
                 else
                 {
-                    char *v = strrchr(c->match_case.pattern, '_');
-                    if (v)
-                    {
-                        v++;
-                    }
-                    else
-                    {
-                        v = c->match_case.pattern;
-                    }
-
-                    if (c->match_case.binding_count > 1)
-                    {
-                        // Tuple destructuring: data.Variant.vI
-                        if (is_r)
-                        {
-                            fprintf(out, "ZC_AUTO %s = &_m_%d->data.%s.v%d; ", bname, id, v, i);
-                        }
-                        else if (has_ref_binding)
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d->data.%s.v%d; ", bname, id, v, i);
-                        }
-                        else
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d.data.%s.v%d; ", bname, id, v, i);
-                        }
-                    }
-                    else
-                    {
-                        // Single destructuring: data.Variant
-                        if (is_r)
-                        {
-                            fprintf(out, "ZC_AUTO %s = &_m_%d->data.%s; ", bname, id, v);
-                        }
-                        else if (has_ref_binding)
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d->data.%s; ", bname, id, v);
-                        }
-                        else
-                        {
-                            fprintf(out, "ZC_AUTO %s = _m_%d.data.%s; ", bname, id, v);
-                        }
-                    }
+                    fprintf(out, "1");
                 }
             }
-        }
-
-        // Check if body is a string literal (should auto-print).
-        ASTNode *body = c->match_case.body;
-        int is_string_literal =
-            (body->type == NODE_EXPR_LITERAL && body->literal.type_kind == LITERAL_STRING);
-
-        if (is_expr)
-        {
-            fprintf(out, "_r_%d = ", id);
-            if (is_string_literal)
-            {
-                codegen_node_single(ctx, body, out);
-            }
-            else
+            else if (is_result)
             {
-                if (body->type == NODE_BLOCK)
+                if (strcmp(c->match_case.pattern, "Ok") == 0)
                 {
-                    int saved = defer_count;
-                    fprintf(out, "({ ");
-                    ASTNode *stmt = body->block.statements;
-                    while (stmt)
-                    {
-                        codegen_node_single(ctx, stmt, out);
-                        stmt = stmt->next;
-                    }
-                    for (int i = defer_count - 1; i >= saved; i--)
-                    {
-                        codegen_node_single(ctx, defer_stack[i], out);
-                    }
-                    defer_count = saved;
-                    fprintf(out, " })");
+                    fprintf(out, "_m_%d->is_ok", id);
+                }
+                else if (strcmp(c->match_case.pattern, "Err") == 0)
+                {
+                    fprintf(out, "!_m_%d->is_ok", id);
                 }
                 else
                 {
-                    codegen_node_single(ctx, body, out);
+                    fprintf(out, "1");
                 }
             }
-            fprintf(out, ";");
-        }
-        else
-        {
-            if (is_string_literal)
-            {
-                char *inner = body->literal.string_val;
-                char *code = process_printf_sugar(ctx, inner, 1, "stdout", NULL, NULL, 0);
-                fprintf(out, "%s;", code);
-                free(code);
-            }
             else
             {
-                codegen_node_single(ctx, body, out);
+                // Use helper for OR patterns, range patterns, and simple patterns
+                emit_pattern_condition(ctx, c->match_case.pattern, id, has_ref_binding, out);
             }
+            fprintf(out, ") { ");
+            emit_match_arm(ctx, c, id, is_expr, is_option, is_result, has_ref_binding, out);
+            fprintf(out, " }");
+            first = 0;
+            c = c->next;
         }
-
-        fprintf(out, " }");
-        first = 0;
-        c = c->next;
     }
 
     if (is_expr)
@@ -833,11 +1456,7 @@ void codegen_node_single(ParserContext *ctx, ASTNode *node, FILE *out)
 
         if (strcmp(node->impl_trait.trait_name, "Drop") == 0)
         {
-            char *tname = node->impl_trait.target_type;
-            fprintf(out, "\n// RAII Glue\n");
-            fprintf(out, "void %s__Drop_glue(%s *self) {\n", tname, tname);
-            fprintf(out, "    %s__Drop_drop(self);\n", tname);
-            fprintf(out, "}\n");
+            emit_drop_glue(node->impl_trait.target_type, out);
         }
         g_current_impl_type = NULL;
         break;
@@ -1801,6 +2420,15 @@ void codegen_node_single(ParserContext *ctx, ASTNode *node, FILE *out)
     }
 }
 
+// RAII glue called by scope cleanup for types implementing Drop.
+void emit_drop_glue(const char *tname, FILE *out)
+{
+    fprintf(out, "\n// RAII Glue\n");
+    fprintf(out, "void %s__Drop_glue(%s *self) {\n", tname, tname);
+    fprintf(out, "    %s__Drop_drop(self);\n", tname);
+    fprintf(out, "}\n");
+}
+
 // Walks AST nodes and generates code.
 void codegen_walker(ParserContext *ctx, ASTNode *node, FILE *out)
 {
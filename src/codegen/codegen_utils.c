@@ -187,6 +187,8 @@ char *get_field_type_str(ParserContext *ctx, const char *struct_name, const char
 }
 
 // Type inference.
+// After lower_program() most expressions already carry a resolved_type, so this
+// is usually a cache hit; the fallbacks below cover scope-dependent nodes.
 char *infer_type(ParserContext *ctx, ASTNode *node)
 {
     if (!node)
@@ -735,6 +737,11 @@ void emit_func_signature(ParserContext *ctx, FILE *out, ASTNode *func, const cha
         return;
     }
 
+    if (func->func.is_internal)
+    {
+        fprintf(out, "static ");
+    }
+
     // Emit CUDA qualifiers (for both forward declarations and definitions)
     if (g_config.use_cuda)
     {
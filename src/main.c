@@ -1,3 +1,4 @@
+#include "analysis/lower.h"
 #include "codegen/codegen.h"
 #include "parser/parser.h"
 #include "plugins/plugin_manager.h"
@@ -33,6 +34,7 @@ void print_usage()
     printf("  run     Compile and run the program\n");
     printf("  build   Compile to executable\n");
     printf("  check   Check for errors only\n");
+    printf("  bench   Compile and run bench blocks (--filter <s>, --json <file>, --time <ms>)\n");
     printf("  repl    Start Interactive REPL\n");
     printf("  transpile Transpile to C code only (no compilation)\n");
     printf("  lsp     Start Language Server\n");
@@ -54,6 +56,47 @@ void print_usage()
     printf("  --cuda          Use CUDA mode (requires nvcc).\n");
 }
 
+// Appends " flag 'value'" to a command line run through the shell, writing
+// each ' in value as '\''. Returns 0 (leaving dst unchanged) if it does not fit.
+static int append_shell_arg(char *dst, size_t cap, const char *flag, const char *value)
+{
+    size_t len = strlen(dst);
+    size_t start = len;
+    int n = snprintf(dst + len, cap - len, " %s '", flag);
+    if (n < 0 || (size_t)n >= cap - len)
+    {
+        dst[start] = 0;
+        return 0;
+    }
+    len += n;
+    for (const char *c = value; *c; c++)
+    {
+        size_t need = *c == '\'' ? 4 : 1;
+        if (len + need + 1 >= cap)
+        {
+            dst[start] = 0;
+            return 0;
+        }
+        if (*c == '\'')
+        {
+            memcpy(dst + len, "'\\''", 4);
+        }
+        else
+        {
+            dst[len] = *c;
+        }
+        len += need;
+    }
+    if (len + 2 > cap)
+    {
+        dst[start] = 0;
+        return 0;
+    }
+    dst[len++] = '\'';
+    dst[len] = 0;
+    return 1;
+}
+
 int main(int argc, char **argv)
 {
     memset(&g_config, 0, sizeof(g_config));
@@ -98,6 +141,11 @@ int main(int argc, char **argv)
     {
         g_config.mode_check = 1;
     }
+    else if (strcmp(command, "bench") == 0)
+    {
+        g_config.mode_bench = 1;
+        g_config.mode_run = 1;
+    }
     else if (strcmp(command, "build") == 0)
     {
         // default mode
@@ -201,6 +249,18 @@ int main(int argc, char **argv)
                 }
             }
         }
+        else if (g_config.mode_bench &&
+                 (strcmp(arg, "--filter") == 0 || strcmp(arg, "--json") == 0 ||
+                  strcmp(arg, "--time") == 0))
+        {
+            // Runner flags, forwarded to the bench binary.
+            if (i + 1 < argc &&
+                !append_shell_arg(g_config.bench_args, sizeof(g_config.bench_args), arg, argv[++i]))
+            {
+                printf("Error: bench arguments too long.\n");
+                return 1;
+            }
+        }
         else if (strcmp(arg, "-o") == 0)
         {
             if (i + 1 < argc)
@@ -244,6 +304,13 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // Timing unoptimized code is rarely what anyone wants.
+    if (g_config.mode_bench && !strstr(g_config.gcc_flags, "-O"))
+    {
+        strncat(g_config.gcc_flags, " -O2",
+                sizeof(g_config.gcc_flags) - strlen(g_config.gcc_flags) - 1);
+    }
+
     g_current_filename = g_config.input_file;
 
     // Load file
@@ -303,6 +370,9 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    // Lower the validated AST into its typed form before emission.
+    lower_program(&ctx, root);
+
     // Determine temporary filename based on mode
     const char *temp_source_file = "out.c";
     if (g_config.use_cuda)
@@ -406,11 +476,11 @@ int main(int argc, char **argv)
         char run_cmd[2048];
         if (z_is_windows())
         {
-            sprintf(run_cmd, "%s", outfile);
+            snprintf(run_cmd, sizeof(run_cmd), "%s%s", outfile, g_config.bench_args);
         }
         else
         {
-            sprintf(run_cmd, "./%s", outfile);
+            snprintf(run_cmd, sizeof(run_cmd), "./%s%s", outfile, g_config.bench_args);
         }
         ret = system(run_cmd);
         remove(outfile);
@@ -130,6 +130,19 @@ typedef struct GenericImplTemplate
     struct GenericImplTemplate *next;
 } GenericImplTemplate;
 
+/**
+ * @brief A method of an instantiated generic impl that is copied on first use.
+ */
+typedef struct LazyMethod
+{
+    char *name;                ///< Mangled method name.
+    GenericImplTemplate *impl; ///< Impl template the method belongs to.
+    ASTNode *method;           ///< The method inside the template impl.
+    char *struct_name;         ///< Mangled name of the instantiated struct.
+    char *subst_arg;           ///< Concrete arguments for the impl's parameters.
+    struct LazyMethod *next;
+} LazyMethod;
+
 /**
  * @brief Represents an imported source file (to prevent cycles/duplication).
  */
@@ -288,6 +301,7 @@ struct ParserContext
     GenericTemplate *templates;              ///< Struct generic templates.
     GenericFuncTemplate *func_templates;     ///< Function generic templates.
     GenericImplTemplate *impl_templates;     ///< Implementation block templates.
+    LazyMethod *lazy_methods;                ///< Impl methods instantiated on first call.
 
     // Instantiations
     Instantiation *instantiations; ///< Cache of instantiated generic types.
@@ -343,6 +357,7 @@ struct ParserContext
     int skip_preamble;  ///< If 1, codegen won't emit standard preamble (includes etc).
     int is_repl;        ///< 1 if running in REPL mode.
     int has_async;      ///< 1 if async/await features are used in the program.
+    int has_bench;      ///< 1 if the program declares `bench` blocks.
     int in_defer_block; ///< 1 if currently parsing inside a defer block.
 
     // Type Validation
@@ -515,6 +530,26 @@ void instantiate_generic(ParserContext *ctx, const char *name, const char *concr
 void instantiate_generic_multi(ParserContext *ctx, const char *name, char **args, int arg_count,
                                Token t);
 
+/**
+ * @brief Checks whether a type name mentions a generic parameter in scope.
+ */
+int type_name_is_generic_dep(ParserContext *ctx, const char *name);
+
+/**
+ * @brief Spells a generic type with nested dependent arguments as `Base<A,B>`.
+ *
+ * @return The spelling, or NULL if the arguments can be mangled directly.
+ */
+char *generic_dep_name(ParserContext *ctx, const char *base, char **args, int count);
+
+/**
+ * @brief Substitutes parameters in a `Base<A,B>` spelling.
+ *
+ * Once no parameter is left the spelling is parsed, which mangles and
+ * instantiates the type.
+ */
+Type *resolve_generic_spelling(const char *name, const char *params, const char *concrete);
+
 /**
  * @brief Sanitizes a mangled name for use in codegen.
  */
@@ -614,6 +649,11 @@ char *replace_type_str(const char *src, const char *param, const char *concrete,
  */
 Type *replace_type_formal(Type *t, const char *p, const char *c, const char *os, const char *ns);
 
+/**
+ * @brief Builds a formal type from a legacy type string (for example, "int*").
+ */
+Type *type_from_string_helper(const char *c);
+
 /**
  * @brief Copies an AST node and replaces its type parameters.
  */
@@ -1,6 +1,7 @@
 
 #include "parser.h"
 #include "zprep.h"
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -400,6 +401,12 @@ ASTNode *parse_program_nodes(ParserContext *ctx, Lexer *l)
             {
                 s = parse_trait(ctx, l);
             }
+            else if (t.len == 5 && strncmp(t.start, "bench", 5) == 0 &&
+                     lexer_peek2(l).type == TOK_STRING)
+            {
+                // Contextual keyword: `bench` stays usable as an identifier.
+                s = parse_test(ctx, l);
+            }
             else if (t.len == 7 && strncmp(t.start, "include", 7) == 0)
             {
                 s = parse_include(ctx, l);
@@ -656,6 +663,373 @@ ASTNode *parse_program(ParserContext *ctx, Lexer *l)
     return r;
 }
 
+// ** @derive(Json) **
+//
+// Serialize emits write_json(), which drives a JsonWriter field by field;
+// Deserialize emits _json_read(), which consumes JsonReader events and stores
+// each value straight into the struct. No JsonValue tree is built either way.
+
+typedef struct DeriveBuf
+{
+    char *data;
+    size_t len;
+    size_t cap;
+} DeriveBuf;
+
+static void dbuf_printf(DeriveBuf *b, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (b->len + n + 1 > b->cap)
+    {
+        b->cap = (b->len + n + 1) * 2;
+        b->data = xrealloc(b->data, b->cap);
+    }
+    va_start(ap, fmt);
+    vsnprintf(b->data + b->len, n + 1, fmt, ap);
+    va_end(ap);
+    b->len += n;
+}
+
+typedef enum
+{
+    JSON_FIELD_UNSUPPORTED,
+    JSON_FIELD_INT,
+    JSON_FIELD_FLOAT,
+    JSON_FIELD_BOOL,
+    JSON_FIELD_CSTR,
+    JSON_FIELD_STRING,
+    JSON_FIELD_VEC,
+    JSON_FIELD_STRUCT
+} JsonFieldKind;
+
+// Generic instantiation substitutes C spellings, so Vec<u16>'s element type
+// arrives as a struct named "uint16_t".
+static JsonFieldKind json_c_name_kind(const char *name)
+{
+    static const char *ints[] = {"int8_t",   "uint8_t",   "int16_t", "uint16_t", "int32_t",
+                                 "uint32_t", "int64_t",   "uint64_t", "int",     "unsigned int",
+                                 "long",     "unsigned long", "short", "unsigned short",
+                                 "size_t",   "ptrdiff_t", "ssize_t", NULL};
+    for (int i = 0; ints[i]; i++)
+    {
+        if (strcmp(name, ints[i]) == 0)
+        {
+            return JSON_FIELD_INT;
+        }
+    }
+    if (strcmp(name, "float") == 0 || strcmp(name, "double") == 0)
+    {
+        return JSON_FIELD_FLOAT;
+    }
+    if (strcmp(name, "bool") == 0)
+    {
+        return JSON_FIELD_BOOL;
+    }
+    if (strcmp(name, "char*") == 0 || strcmp(name, "const char*") == 0)
+    {
+        return JSON_FIELD_CSTR;
+    }
+    return JSON_FIELD_UNSUPPORTED;
+}
+
+// Classifies a field type; for Vec<T> the element type is stored in *elem.
+static JsonFieldKind json_field_kind(ParserContext *ctx, Type *t, Type **elem)
+{
+    if (!t)
+    {
+        return JSON_FIELD_UNSUPPORTED;
+    }
+    switch (t->kind)
+    {
+    case TYPE_I8:
+    case TYPE_U8:
+    case TYPE_I16:
+    case TYPE_U16:
+    case TYPE_I32:
+    case TYPE_U32:
+    case TYPE_I64:
+    case TYPE_U64:
+    case TYPE_INT:
+    case TYPE_UINT:
+    case TYPE_USIZE:
+    case TYPE_ISIZE:
+    case TYPE_BYTE:
+    case TYPE_RUNE:
+    case TYPE_C_INT:
+    case TYPE_C_UINT:
+    case TYPE_C_LONG:
+    case TYPE_C_ULONG:
+    case TYPE_C_SHORT:
+    case TYPE_C_USHORT:
+        return JSON_FIELD_INT;
+    case TYPE_F32:
+    case TYPE_F64:
+    case TYPE_FLOAT:
+        return JSON_FIELD_FLOAT;
+    case TYPE_BOOL:
+        return JSON_FIELD_BOOL;
+    case TYPE_STRING:
+        return JSON_FIELD_CSTR;
+    case TYPE_POINTER:
+        if (t->inner && (t->inner->kind == TYPE_CHAR || t->inner->kind == TYPE_C_CHAR))
+        {
+            return JSON_FIELD_CSTR;
+        }
+        return JSON_FIELD_UNSUPPORTED;
+    case TYPE_STRUCT:
+    {
+        if (!t->name)
+        {
+            return JSON_FIELD_UNSUPPORTED;
+        }
+        if (strcmp(t->name, "String") == 0)
+        {
+            return JSON_FIELD_STRING;
+        }
+        JsonFieldKind prim = json_c_name_kind(t->name);
+        if (prim != JSON_FIELD_UNSUPPORTED)
+        {
+            return prim;
+        }
+        ASTNode *def = find_struct_def(ctx, t->name);
+        if (def && def->type == NODE_ENUM)
+        {
+            return JSON_FIELD_UNSUPPORTED;
+        }
+        if (def && strncmp(t->name, "Vec_", 4) == 0)
+        {
+            for (ASTNode *f = def->strct.fields; f; f = f->next)
+            {
+                if (f->type == NODE_FIELD && strcmp(f->field.name, "data") == 0 &&
+                    f->type_info && f->type_info->kind == TYPE_POINTER)
+                {
+                    *elem = f->type_info->inner;
+                    return JSON_FIELD_VEC;
+                }
+            }
+        }
+        // Structs declared later in the file are not registered yet; they
+        // must derive Json themselves.
+        return JSON_FIELD_STRUCT;
+    }
+    default:
+        return JSON_FIELD_UNSUPPORTED;
+    }
+}
+
+static int derive_json_write(ParserContext *ctx, DeriveBuf *b, Type *t, const char *expr, int depth)
+{
+    Type *elem = NULL;
+    switch (json_field_kind(ctx, t, &elem))
+    {
+    case JSON_FIELD_INT:
+        dbuf_printf(b, "w.integer(%s);\n", expr);
+        return 1;
+    case JSON_FIELD_FLOAT:
+        dbuf_printf(b, "w.number(%s);\n", expr);
+        return 1;
+    case JSON_FIELD_BOOL:
+        dbuf_printf(b, "w.bool(%s);\n", expr);
+        return 1;
+    case JSON_FIELD_CSTR:
+        dbuf_printf(b, "if (%s == NULL) { w.null(); } else { w.string(%s); }\n", expr, expr);
+        return 1;
+    case JSON_FIELD_STRING:
+        dbuf_printf(b, "w.string_bytes(%s.as_ptr(), %s.length());\n", expr, expr);
+        return 1;
+    case JSON_FIELD_STRUCT:
+        dbuf_printf(b, "%s.write_json(w);\n", expr);
+        return 1;
+    case JSON_FIELD_VEC:
+    {
+        char *item = xmalloc(strlen(expr) + 32);
+        sprintf(item, "%s.data[_i%d]", expr, depth);
+        dbuf_printf(b,
+                    "w.begin_array();\n"
+                    "for (let _i%d: usize = 0; _i%d < %s.len; _i%d = _i%d + 1) {\n",
+                    depth, depth, expr, depth, depth);
+        int ok = derive_json_write(ctx, b, elem, item, depth + 1);
+        dbuf_printf(b, "}\nw.end_array();\n");
+        return ok;
+    }
+    default:
+        return 0;
+    }
+}
+
+// Reads the value whose first event code is in `ev` into `target`. Every
+// branch assigns `target`, so Vec slots need no prior initialization except
+// for nested Vecs, which are grown in place.
+static int derive_json_read(ParserContext *ctx, DeriveBuf *b, Type *t, const char *target,
+                            const char *ev, const char *self_name, const char *field, int depth)
+{
+    char fail[512];
+    snprintf(fail, sizeof(fail),
+             "return Result<%s>::Err(r._fail(\"Field '%s' of %s has the wrong JSON type\"));",
+             self_name, field, self_name);
+
+    Type *elem = NULL;
+    switch (json_field_kind(ctx, t, &elem))
+    {
+    case JSON_FIELD_INT:
+        dbuf_printf(b, "let _t%d: I64 = 0;\nif (!r._read_i64(%s, &_t%d)) { %s }\n%s = _t%d;\n",
+                    depth, ev, depth, fail, target, depth);
+        return 1;
+    case JSON_FIELD_FLOAT:
+        dbuf_printf(b,
+                    "let _t%d: double = 0.0;\nif (!r._read_f64(%s, &_t%d)) { %s }\n%s = _t%d;\n",
+                    depth, ev, depth, fail, target, depth);
+        return 1;
+    case JSON_FIELD_BOOL:
+        dbuf_printf(b, "if (!r._read_bool(%s, &%s)) { %s }\n", ev, target, fail);
+        return 1;
+    case JSON_FIELD_CSTR:
+        dbuf_printf(b, "if (!r._read_cstr(%s, &%s)) { %s }\n", ev, target, fail);
+        return 1;
+    case JSON_FIELD_STRING:
+        dbuf_printf(b, "if (!r._read_string(%s, &%s)) { %s }\n", ev, target, fail);
+        return 1;
+    case JSON_FIELD_STRUCT:
+        dbuf_printf(b,
+                    "let _s%d = %s::_json_read(r, %s);\n"
+                    "if (!_s%d.is_ok) { return Result<%s>::Err(_s%d.err); }\n"
+                    "%s = _s%d.val;\n",
+                    depth, t->name, ev, depth, self_name, depth, target, depth);
+        return 1;
+    case JSON_FIELD_VEC:
+    {
+        char *slot = xmalloc(2 * strlen(target) + 32);
+        sprintf(slot, "%s.data[%s.len]", target, target);
+        char next_ev[32];
+        sprintf(next_ev, "_e%d", depth);
+        dbuf_printf(b,
+                    "if (%s == 2) {\n"
+                    "while (true) {\n"
+                    "let _e%d = r._next_code();\n"
+                    "if (_e%d == 3) { break; }\n"
+                    "if (%s.len >= %s.cap) { %s.grow(); }\n",
+                    ev, depth, depth, target, target, target);
+        Type *inner = NULL;
+        if (json_field_kind(ctx, elem, &inner) == JSON_FIELD_VEC)
+        {
+            dbuf_printf(b, "%s.data = NULL;\n%s.len = 0;\n%s.cap = 0;\n", slot, slot, slot);
+        }
+        int ok = derive_json_read(ctx, b, elem, slot, next_ev, self_name, field, depth + 1);
+        dbuf_printf(b, "%s.len = %s.len + 1;\n}\n} else if (%s != 8) { %s }\n", target, target,
+                    ev, fail);
+        return ok;
+    }
+    default:
+        return 0;
+    }
+}
+
+static char *derive_json_code(ParserContext *ctx, ASTNode *strct, int ser, int de)
+{
+    char *name = strct->strct.name;
+    DeriveBuf b = {0};
+    dbuf_printf(&b, "impl %s {\n", name);
+
+    if (ser)
+    {
+        dbuf_printf(&b, "fn write_json(self, w: JsonWriter*) {\nw.begin_object();\n");
+        for (ASTNode *f = strct->strct.fields; f; f = f->next)
+        {
+            if (f->type != NODE_FIELD || !f->field.name)
+            {
+                continue;
+            }
+            char expr[256];
+            snprintf(expr, sizeof(expr), "self.%s", f->field.name);
+            dbuf_printf(&b, "w.key_bytes(\"%s\", %zu);\n", f->field.name, strlen(f->field.name));
+            if (!derive_json_write(ctx, &b, f->type_info, expr, 0))
+            {
+                zpanic_at(strct->token, "@derive(Json): field '%s' of %s has unsupported type '%s'",
+                          f->field.name, name, f->field.type);
+            }
+        }
+        dbuf_printf(&b, "w.end_object();\n}\n");
+        dbuf_printf(&b,
+                    "fn to_json_string(self) -> String {\n"
+                    "let _w = JsonWriter::new();\nself.write_json(&_w);\nreturn _w.out;\n}\n");
+    }
+
+    if (de)
+    {
+        dbuf_printf(&b,
+                    "fn _json_read(r: JsonReader*, ev: int) -> Result<%s> {\n"
+                    "if (ev != 0) { return Result<%s>::Err(r._fail(\"Expected a JSON object for "
+                    "%s\")); }\n"
+                    "let _v: %s;\n",
+                    name, name, name, name);
+        for (ASTNode *f = strct->strct.fields; f; f = f->next)
+        {
+            Type *elem = NULL;
+            if (f->type == NODE_FIELD && f->field.name &&
+                json_field_kind(ctx, f->type_info, &elem) == JSON_FIELD_STRING)
+            {
+                dbuf_printf(&b, "_v.%s = String::new(\"\");\n", f->field.name);
+            }
+        }
+        dbuf_printf(&b, "while (true) {\n"
+                        "let _k = r._next_code();\n"
+                        "if (_k == 1) { break; }\n"
+                        "if (_k != 4) { return Result<%s>::Err(r._fail(\"Malformed JSON object\")); }\n"
+                        "let _key = r.str();\n"
+                        "let _f = -1;\n",
+                    name);
+        int idx = 0;
+        for (ASTNode *f = strct->strct.fields; f; f = f->next)
+        {
+            if (f->type == NODE_FIELD && f->field.name)
+            {
+                dbuf_printf(&b, "%sif (_key.eq_str(\"%s\")) { _f = %d; }\n", idx ? "else " : "",
+                            f->field.name, idx);
+                idx++;
+            }
+        }
+        dbuf_printf(&b, "let _e = r._next_code();\n");
+        idx = 0;
+        for (ASTNode *f = strct->strct.fields; f; f = f->next)
+        {
+            if (f->type != NODE_FIELD || !f->field.name)
+            {
+                continue;
+            }
+            char target[256];
+            snprintf(target, sizeof(target), "_v.%s", f->field.name);
+            dbuf_printf(&b, "%sif (_f == %d) {\n", idx ? "else " : "", idx);
+            if (!derive_json_read(ctx, &b, f->type_info, target, "_e", name, f->field.name, 0))
+            {
+                zpanic_at(strct->token, "@derive(Json): field '%s' of %s has unsupported type '%s'",
+                          f->field.name, name, f->field.type);
+            }
+            dbuf_printf(&b, "}\n");
+            idx++;
+        }
+        dbuf_printf(&b,
+                    "%sif (!r._skip_value(_e)) { return Result<%s>::Err(r._fail(\"Malformed JSON "
+                    "value\")); }\n"
+                    "}\n"
+                    "return Result<%s>::Ok(_v);\n}\n",
+                    idx ? "else " : "", name, name);
+        dbuf_printf(&b,
+                    "fn read_json(r: JsonReader*) -> Result<%s> {\n"
+                    "return %s::_json_read(r, r._next_code());\n}\n"
+                    "fn from_json_str(text: char*) -> Result<%s> {\n"
+                    "let _r = JsonReader::from_str(text);\n"
+                    "let _res = %s::read_json(&_r);\n"
+                    "_r.close();\nreturn _res;\n}\n",
+                    name, name, name, name);
+    }
+
+    dbuf_printf(&b, "}\n");
+    return b.data;
+}
+
 static ASTNode *generate_derive_impls(ParserContext *ctx, ASTNode *strct, char **traits, int count)
 {
     ASTNode *head = NULL, *tail = NULL;
@@ -758,6 +1132,17 @@ static ASTNode *generate_derive_impls(ParserContext *ctx, ASTNode *strct, char *
             code = xmalloc(1024);
             sprintf(code, "impl Copy for %s {}", name);
         }
+        else if (0 == strcmp(trait, "Json") || 0 == strcmp(trait, "Serialize") ||
+                 0 == strcmp(trait, "Deserialize"))
+        {
+            if (strct->type != NODE_STRUCT)
+            {
+                zwarn_at(strct->token, "@derive(%s) only works on structs", trait);
+                continue;
+            }
+            code = derive_json_code(ctx, strct, strcmp(trait, "Deserialize") != 0,
+                                    strcmp(trait, "Serialize") != 0);
+        }
         else if (0 == strcmp(trait, "FromJson"))
         {
             // Generate from_json(j: JsonValue*) -> Result<StructName>
@@ -956,7 +1341,7 @@ static ASTNode *generate_derive_impls(ParserContext *ctx, ASTNode *strct, char *
                     }
                     else if (strcmp(ft, "String") == 0)
                     {
-                        sprintf(set_call, "_obj.set(\"%s\", JsonValue::string(self.%s.c_str()));\n",
+                        sprintf(set_call, "_obj.set(\"%s\", JsonValue::string(self.%s.as_ptr()));\n",
                                 fn, fn);
                     }
                     else if (ft && strstr(ft, "Vec") && strstr(ft, "String"))
@@ -965,7 +1350,7 @@ static ASTNode *generate_derive_impls(ParserContext *ctx, ASTNode *strct, char *
                                 "let _arr_%s = JsonValue::array();\n"
                                 "for let _i_%s: usize = 0; _i_%s < self.%s.length(); _i_%s = _i_%s "
                                 "+ 1 {\n"
-                                "  _arr_%s.push(JsonValue::string(self.%s.get(_i_%s).c_str()));\n"
+                                "  _arr_%s.push(JsonValue::string(self.%s.data[_i_%s].as_ptr()));\n"
                                 "}\n"
                                 "_obj.set(\"%s\", _arr_%s);\n",
                                 fn, fn, fn, fn, fn, fn, fn, fn, fn, fn, fn);
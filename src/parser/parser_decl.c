@@ -11,6 +11,7 @@
 #include "../zen/zen_facts.h"
 #include "zprep_plugin.h"
 #include "../codegen/codegen.h"
+#include "../analysis/fold.h"
 
 ASTNode *parse_function(ParserContext *ctx, Lexer *l, int is_async)
 {
@@ -230,12 +231,12 @@ char *patch_self_args(const char *args, const char *struct_name)
         return NULL;
     }
 
-    // Sanitize struct name for C usage (Vec<T> -> Vec_T)
+    // Sanitize struct name for C usage (Vec<T> -> Vec_T, Map<K,V> -> Map_K_V)
     char *safe_name = xmalloc(strlen(struct_name) + 1);
     int j = 0;
     for (int i = 0; struct_name[i]; i++)
     {
-        if (struct_name[i] == '<')
+        if (struct_name[i] == '<' || struct_name[i] == ',')
         {
             safe_name[j++] = '_';
         }
@@ -865,12 +866,24 @@ ASTNode *parse_def(ParserContext *ctx, Lexer *l)
     if (lexer_peek(l).type == TOK_OP && is_token(lexer_peek(l), "="))
     {
         lexer_next(l);
+        int starts_with_int = lexer_peek(l).type == TOK_INT;
 
-        // Check for constant integer literal
-        if (lexer_peek(l).type == TOK_INT)
+        if (lexer_peek(l).type == TOK_LPAREN && type_str && strncmp(type_str, "Tuple_", 6) == 0)
+        {
+            char *code = parse_tuple_literal(ctx, l, type_str);
+            i = ast_create(NODE_RAW_STMT);
+            i->raw_stmt.content = code;
+        }
+        else
         {
-            Token val_tok = lexer_peek(l);
-            int val = (int)strtol(token_strdup(val_tok), NULL, 0); // support hex/octal
+            i = parse_expression(ctx, l);
+        }
+
+        // Integer constant expressions (`4 * 1024`, `K + 1`, `-8`) become manifest constants.
+        long long folded = 0;
+        if (i->type != NODE_RAW_STMT && fold_const_expr(i, &folded))
+        {
+            int val = (int)folded;
 
             ZenSymbol *s = find_symbol_entry(ctx, ns);
             if (s)
@@ -895,16 +908,25 @@ ASTNode *parse_def(ParserContext *ctx, Lexer *l)
                 }
             }
         }
-
-        if (lexer_peek(l).type == TOK_LPAREN && type_str && strncmp(type_str, "Tuple_", 6) == 0)
+        else if (!type_str && i->type != NODE_RAW_STMT)
         {
-            char *code = parse_tuple_literal(ctx, l, type_str);
-            i = ast_create(NODE_RAW_STMT);
-            i->raw_stmt.content = code;
-        }
-        else
-        {
-            i = parse_expression(ctx, l);
+            // Not foldable (e.g. it overflows int): still give the def a type
+            // so uses like `let x = A;` can be declared.
+            ZenSymbol *s = find_symbol_entry(ctx, ns);
+            Type *t = i->type_info;
+            if (s && t && t->kind != TYPE_UNKNOWN)
+            {
+                s->type_info = xmalloc(sizeof(Type));
+                *s->type_info = *t;
+                s->type_info->is_const = 1;
+                s->type_name = type_to_string(t);
+            }
+            else if (s && starts_with_int)
+            {
+                s->type_info = type_new(TYPE_INT);
+                s->type_info->is_const = 1;
+                s->type_name = xstrdup("int");
+            }
         }
     }
     else
@@ -2000,7 +2000,8 @@ ASTNode *parse_primary(ParserContext *ctx, Lexer *l)
                                 {
                                     char *gname = gt->name;
                                     int glen = strlen(gname);
-                                    if ((strncmp(acc, gname, glen) == 0 && acc[glen] == '_') ||
+                                    if ((strncmp(acc, gname, glen) == 0 &&
+                                         (acc[glen] == '_' || acc[glen] == '<')) ||
                                         strcmp(acc, gname) == 0)
                                     {
                                         ASTNode *tpl_def = gt->struct_node;
@@ -2120,7 +2121,7 @@ ASTNode *parse_primary(ParserContext *ctx, Lexer *l)
 
                     if (is_struct)
                     {
-                        char mangled[256];
+                        char mangled[1024];
                         strcpy(mangled, acc);
                         int is_generic_dep = 0;
                         for (int i = 0; i < arg_count; ++i)
@@ -2139,7 +2140,25 @@ ASTNode *parse_primary(ParserContext *ctx, Lexer *l)
                             free(clean);
                         }
 
-                        if (arg_count == 1)
+                        char *spelled = NULL;
+                        if (arg_count > 1)
+                        {
+                            for (int i = 0; i < arg_count && !is_generic_dep; ++i)
+                            {
+                                is_generic_dep = type_name_is_generic_dep(ctx, concrete_types[i]);
+                            }
+                        }
+                        if (is_generic_dep || (arg_count == 1 && type_name_is_generic_dep(ctx, concrete_types[0])))
+                        {
+                            spelled = generic_dep_name(ctx, acc, concrete_types, arg_count);
+                        }
+
+                        if (spelled)
+                        {
+                            free(acc);
+                            acc = spelled;
+                        }
+                        else if (arg_count == 1)
                         {
                             // Single-arg: only instantiate if not generic dependent
                             if (!is_generic_dep)
@@ -2950,6 +2969,17 @@ ASTNode *parse_primary(ParserContext *ctx, Lexer *l)
                 node->literal.type_kind = LITERAL_INT; // INT (assumed for now from const_int_val)
                 node->literal.int_val = sym->const_int_val;
                 node->type_info = type_new(TYPE_INT);
+                if (sym->const_int_val < 0)
+                {
+                    // Negative values are emitted as `-literal`, like they parse.
+                    node->literal.int_val = -(long long)sym->const_int_val;
+                    ASTNode *neg = ast_create(NODE_EXPR_UNARY);
+                    neg->token = t;
+                    neg->unary.op = xstrdup("-");
+                    neg->unary.operand = node;
+                    neg->type_info = type_new(TYPE_INT);
+                    node = neg;
+                }
                 // No need for resolution
             }
             else
@@ -3397,7 +3427,7 @@ ASTNode *parse_primary(ParserContext *ctx, Lexer *l)
                 char *struct_name = (st->kind == TYPE_STRUCT) ? st->name : st->inner->name;
                 int is_ptr = (st->kind == TYPE_POINTER);
 
-                char mangled[256];
+                char mangled[1024];
                 sprintf(mangled, "%s__get", struct_name);
                 FuncSig *sig = find_func(ctx, mangled);
                 if (sig)
@@ -4131,7 +4161,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
             if (struct_name)
             {
-                char mangled[256];
+                char mangled[1024];
                 sprintf(mangled, "%s__%s", struct_name, method);
 
                 if (find_func(ctx, mangled))
@@ -4553,7 +4583,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
                 if (struct_name)
                 {
-                    char mangled[256];
+                    char mangled[1024];
                     sprintf(mangled, "%s__%s", struct_name, lhs->member.field);
                     FuncSig *sig = find_func(ctx, mangled);
 
@@ -4968,7 +4998,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
                 if (struct_name)
                 {
-                    char mangled[256];
+                    char mangled[1024];
                     sprintf(mangled, "%s__get", struct_name);
 
                     if (find_func(ctx, mangled))
@@ -5157,7 +5187,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
                 if (struct_name)
                 {
-                    char mangled[256];
+                    char mangled[1024];
                     sprintf(mangled, "%s__%s", struct_name, node->member.field);
 
                     FuncSig *sig = find_func(ctx, mangled);
@@ -5558,7 +5588,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
                 if (struct_name)
                 {
-                    char mangled[256];
+                    char mangled[1024];
                     sprintf(mangled, "%s__%s", struct_name, inner_method);
                     FuncSig *sig = find_func(ctx, mangled);
                     if (sig)
@@ -5709,6 +5739,14 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
                     free(r_alloc);
                 }
 
+                // `p == NULL` / `p != 0` are null checks, not value comparisons.
+                if ((rhs->type == NODE_EXPR_VAR && strcmp(rhs->var_ref.name, "NULL") == 0) ||
+                    (rhs->type == NODE_EXPR_LITERAL && rhs->literal.type_kind == LITERAL_INT &&
+                     rhs->literal.int_val == 0))
+                {
+                    is_rhs_ptr = 1;
+                }
+
                 if (is_rhs_ptr)
                 {
                     // Both are pointers: Skip rewrite to allow pointer comparison
@@ -5722,7 +5760,7 @@ ASTNode *parse_expr_prec(ParserContext *ctx, Lexer *l, Precedence min_prec)
 
             if (struct_name)
             {
-                char mangled[256];
+                char mangled[1024];
                 sprintf(mangled, "%s__%s", struct_name, method);
 
                 FuncSig *sig = find_func(ctx, mangled);
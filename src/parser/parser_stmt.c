@@ -924,11 +924,13 @@ ASTNode *parse_asm(ParserContext *ctx, Lexer *l)
 
 ASTNode *parse_test(ParserContext *ctx, Lexer *l)
 {
-    lexer_next(l); // eat 'test'
+    Token kw = lexer_next(l); // eat 'test' or 'bench'
+    int is_bench = (kw.type == TOK_IDENT);
     Token t = lexer_next(l);
     if (t.type != TOK_STRING)
     {
-        zpanic_at(t, "Test name must be a string literal");
+        zpanic_at(t, is_bench ? "Benchmark name must be a string literal"
+                              : "Test name must be a string literal");
     }
 
     // Strip quotes for AST storage
@@ -941,6 +943,11 @@ ASTNode *parse_test(ParserContext *ctx, Lexer *l)
     ASTNode *n = ast_create(NODE_TEST);
     n->test_stmt.name = name;
     n->test_stmt.body = body;
+    n->test_stmt.is_bench = is_bench;
+    if (is_bench)
+    {
+        ctx->has_bench = 1;
+    }
     return n;
 }
 
@@ -1774,7 +1781,7 @@ char *process_printf_sugar(ParserContext *ctx, const char *content, int newline,
 
                 if (struct_name)
                 {
-                    char mangled[256];
+                    char mangled[1024];
                     sprintf(mangled, "%s__to_string", struct_name);
                     if (find_func(ctx, mangled))
                     {
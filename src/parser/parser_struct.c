@@ -207,8 +207,11 @@ ASTNode *parse_trait(ParserContext *ctx, Lexer *l)
         Type **arg_types = NULL;
         char **param_names = NULL;
         int is_varargs = 0;
+        // Parameters are scoped to the signature, like in parse_function().
+        enter_scope(ctx);
         char *args = parse_and_convert_args(ctx, l, &defaults, &arg_count, &arg_types, &param_names,
                                             &is_varargs, NULL);
+        exit_scope(ctx);
 
         char *ret = xstrdup("void");
         if (lexer_peek(l).type == TOK_ARROW)
@@ -224,6 +227,8 @@ ASTNode *parse_trait(ParserContext *ctx, Lexer *l)
             lexer_next(l);
             ASTNode *m = ast_create(NODE_FUNCTION);
             m->func.param_names = param_names;
+            m->func.arg_types = arg_types;
+            m->func.arg_count = arg_count;
             m->func.name = mname;
             m->func.args = args;
             m->func.ret_type = ret;
@@ -261,6 +266,66 @@ ASTNode *parse_trait(ParserContext *ctx, Lexer *l)
     return n_node;
 }
 
+// Parses `<A, B, ...>` after an impl name and registers every parameter as
+// generic. Returns the parameters comma-joined ("A,B"), the form the template
+// substitution helpers expect.
+static char *parse_impl_generic_params(ParserContext *ctx, Lexer *l, int *count, const char *err)
+{
+    lexer_next(l); // eat <
+    char *joined = xstrdup("");
+    *count = 0;
+    while (1)
+    {
+        Token gt = lexer_next(l);
+        char *param = token_strdup(gt);
+        register_generic(ctx, param);
+        char *next = xmalloc(strlen(joined) + strlen(param) + 2);
+        sprintf(next, "%s%s%s", joined, *count ? "," : "", param);
+        free(joined);
+        joined = next;
+        free(param);
+        (*count)++;
+        if (lexer_peek(l).type != TOK_COMMA)
+        {
+            break;
+        }
+        lexer_next(l); // eat ,
+    }
+    if (lexer_next(l).type != TOK_RANGLE)
+    {
+        zpanic_at(lexer_peek(l), err);
+    }
+    return joined;
+}
+
+// Type of `self` in a generic impl: Foo<A, B>*.
+static Type *impl_self_type(const char *name, const char *gen_param)
+{
+    Type *t_struct = type_new(TYPE_STRUCT);
+    t_struct->name = xstrdup(name);
+    t_struct->arg_count = 1;
+    for (const char *c = gen_param; *c; c++)
+    {
+        t_struct->arg_count += (*c == ',');
+    }
+    t_struct->args = xmalloc(sizeof(Type *) * t_struct->arg_count);
+
+    char *params = xstrdup(gen_param);
+    char *saveptr;
+    int i = 0;
+    for (char *p = strtok_r(params, ",", &saveptr); p; p = strtok_r(NULL, ",", &saveptr))
+    {
+        t_struct->args[i] = type_new(TYPE_GENERIC);
+        t_struct->args[i]->name = xstrdup(p);
+        i++;
+    }
+    free(params);
+
+    Type *t_ptr = type_new(TYPE_POINTER);
+    t_ptr->inner = t_struct;
+    return t_ptr;
+}
+
 ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
 {
 
@@ -276,21 +341,11 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
     name1 = final_name;
 
     char *gen_param = NULL;
-    // Check for <T> on the struct name
+    int gen_count = 0;
+    // Check for <T> (or <K, V>) on the struct name
     if (lexer_peek(l).type == TOK_LANGLE)
     {
-        lexer_next(l); // eat <
-        Token gt = lexer_next(l);
-        gen_param = token_strdup(gt);
-        if (lexer_next(l).type != TOK_RANGLE)
-        {
-            zpanic_at(lexer_peek(l), "Expected >");
-        }
-    }
-
-    if (gen_param)
-    {
-        register_generic(ctx, gen_param);
+        gen_param = parse_impl_generic_params(ctx, l, &gen_count, "Expected >");
     }
 
     // Check for "for" (Trait impl)
@@ -310,16 +365,11 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
         char *name2 = token_strdup(t2);
 
         char *target_gen_param = NULL;
+        int target_gen_count = 0;
         if (lexer_peek(l).type == TOK_LANGLE)
         {
-            lexer_next(l); // eat <
-            Token gt = lexer_next(l);
-            target_gen_param = token_strdup(gt);
-            if (lexer_next(l).type != TOK_RANGLE)
-            {
-                zpanic_at(lexer_peek(l), "Expected > in impl struct generic");
-            }
-            register_generic(ctx, target_gen_param);
+            target_gen_param = parse_impl_generic_params(ctx, l, &target_gen_count,
+                                                         "Expected > in impl struct generic");
         }
 
         // Check for common error: swapped Struct and Trait
@@ -523,14 +573,7 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
             register_impl_template(ctx, name2, gp, n);
         }
 
-        if (gen_param)
-        {
-            ctx->known_generics_count--;
-        }
-        if (target_gen_param)
-        {
-            ctx->known_generics_count--;
-        }
+        ctx->known_generics_count -= gen_count + target_gen_count;
         return n;
     }
     else
@@ -587,17 +630,7 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
                     if (f->func.arg_count > 0 && f->func.param_names &&
                         strcmp(f->func.param_names[0], "self") == 0)
                     {
-                        Type *t_struct = type_new(TYPE_STRUCT);
-                        t_struct->name = xstrdup(name1);
-                        t_struct->arg_count = 1;
-                        t_struct->args = xmalloc(sizeof(Type *));
-                        t_struct->args[0] = type_new(TYPE_GENERIC);
-                        t_struct->args[0]->name = xstrdup(gen_param);
-
-                        Type *t_ptr = type_new(TYPE_POINTER);
-                        t_ptr->inner = t_struct;
-
-                        f->func.arg_types[0] = t_ptr;
+                        f->func.arg_types[0] = impl_self_type(name1, gen_param);
                     }
 
                     if (!h)
@@ -630,17 +663,7 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
                         if (f->func.arg_count > 0 && f->func.param_names &&
                             strcmp(f->func.param_names[0], "self") == 0)
                         {
-                            Type *t_struct = type_new(TYPE_STRUCT);
-                            t_struct->name = xstrdup(name1);
-                            t_struct->arg_count = 1;
-                            t_struct->args = xmalloc(sizeof(Type *));
-                            t_struct->args[0] = type_new(TYPE_GENERIC);
-                            t_struct->args[0]->name = xstrdup(gen_param);
-
-                            Type *t_ptr = type_new(TYPE_POINTER);
-                            t_ptr->inner = t_struct;
-
-                            f->func.arg_types[0] = t_ptr;
+                            f->func.arg_types[0] = impl_self_type(name1, gen_param);
                         }
 
                         if (!h)
@@ -670,10 +693,7 @@ ASTNode *parse_impl(ParserContext *ctx, Lexer *l)
             n->impl.methods = h;
             register_impl_template(ctx, name1, gen_param, n);
             ctx->current_impl_struct = NULL;
-            if (gen_param)
-            {
-                ctx->known_generics_count--;
-            }
+            ctx->known_generics_count -= gen_count;
             return NULL; // Do not emit generic template
         }
         else
@@ -1173,7 +1193,7 @@ ASTNode *parse_enum(ParserContext *ctx, Lexer *l)
             va->variant.payload = payload; // Store Type*
 
             // Register Variant (Mangled name to avoid collisions: Result_Ok)
-            char mangled[256];
+            char mangled[1024];
             sprintf(mangled, "%s_%s", ename, vname);
             register_enum_variant(ctx, ename, mangled, va->variant.tag_id);
 
@@ -595,13 +595,10 @@ Type *parse_type_base(ParserContext *ctx, Lexer *l)
                 int is_generic_dep = 0;
                 for (int i = 0; i < arg_count; ++i)
                 {
-                    for (int k = 0; k < ctx->known_generics_count; ++k)
+                    if (type_name_is_generic_dep(ctx, args[i]))
                     {
-                        if (strcmp(args[i], ctx->known_generics[k]) == 0)
-                        {
-                            is_generic_dep = 1;
-                            break;
-                        }
+                        is_generic_dep = 1;
+                        break;
                     }
                 }
 
@@ -610,8 +607,25 @@ Type *parse_type_base(ParserContext *ctx, Lexer *l)
                     instantiate_generic_multi(ctx, name, args, arg_count, t);
                 }
 
+                char *spelled = is_generic_dep ? generic_dep_name(ctx, name, args, arg_count) : NULL;
+                if (spelled)
+                {
+                    for (int i = 0; i < arg_count; i++)
+                    {
+                        free(args[i]);
+                    }
+                    free(args);
+                    free(first_arg_str);
+                    free(ty->name);
+                    ty->name = spelled;
+                    ty->kind = TYPE_STRUCT;
+                    ty->args = NULL;
+                    ty->arg_count = 0;
+                    return ty;
+                }
+
                 // Build mangled name
-                char mangled[256];
+                char mangled[1024];
                 strcpy(mangled, name);
                 for (int i = 0; i < arg_count; i++)
                 {
@@ -657,6 +671,21 @@ Type *parse_type_base(ParserContext *ctx, Lexer *l)
                     }
                 }
 
+                char *spelled = type_name_is_generic_dep(ctx, first_arg_str)
+                                    ? generic_dep_name(ctx, name, &first_arg_str, 1)
+                                    : NULL;
+                if (spelled)
+                {
+                    free(unmangled_arg);
+                    free(first_arg_str);
+                    free(ty->name);
+                    ty->name = spelled;
+                    ty->kind = TYPE_STRUCT;
+                    ty->args = NULL;
+                    ty->arg_count = 0;
+                    return ty;
+                }
+
                 if (!is_single_dep)
                 {
                     instantiate_generic(ctx, name, first_arg_str, unmangled_arg, t);
@@ -664,7 +693,7 @@ Type *parse_type_base(ParserContext *ctx, Lexer *l)
                 free(unmangled_arg);
 
                 char *clean_arg = sanitize_mangled_name(first_arg_str);
-                char mangled[256];
+                char mangled[1024];
                 sprintf(mangled, "%s_%s", name, clean_arg);
                 free(clean_arg);
 
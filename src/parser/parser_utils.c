@@ -373,6 +373,223 @@ int is_known_generic(ParserContext *ctx, char *name)
     return 0;
 }
 
+// ** Dependent Generic Spellings **
+//
+// Inside a template, a generic whose arguments are themselves generic (e.g.
+// `Map<VecIter<T>, T, U>`) cannot be mangled yet: `Map_VecIter_T_T_U` no
+// longer says where each argument ends, so substitution would miss the inner
+// `T`. Such types keep their source spelling until every parameter has been
+// replaced, and are then parsed again to mangle and instantiate them.
+
+static int is_generic_token(ParserContext *ctx, const char *s, int len)
+{
+    for (int i = 0; i < ctx->known_generics_count; i++)
+    {
+        if ((int)strlen(ctx->known_generics[i]) == len &&
+            strncmp(ctx->known_generics[i], s, len) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int type_name_is_generic_dep(ParserContext *ctx, const char *name)
+{
+    const char *p = name;
+    while (*p)
+    {
+        if (!isalnum((unsigned char)*p))
+        {
+            p++;
+            continue;
+        }
+        const char *s = p;
+        while (isalnum((unsigned char)*p))
+        {
+            p++;
+        }
+        if (is_generic_token(ctx, s, (int)(p - s)))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Recovers `VecIter<T>` from an already mangled dependent name like `VecIter_T`.
+static char *generic_dep_spelling(ParserContext *ctx, const char *arg)
+{
+    if (strchr(arg, '<') || is_known_generic(ctx, (char *)arg) ||
+        !type_name_is_generic_dep(ctx, arg))
+    {
+        return xstrdup(arg);
+    }
+
+    GenericTemplate *best = NULL;
+    size_t best_len = 0;
+    for (GenericTemplate *g = ctx->templates; g; g = g->next)
+    {
+        size_t len = strlen(g->name);
+        if (len > best_len && strncmp(arg, g->name, len) == 0 && arg[len] == '_' &&
+            type_name_is_generic_dep(ctx, arg + len + 1))
+        {
+            best = g;
+            best_len = len;
+        }
+    }
+    if (!best)
+    {
+        return xstrdup(arg);
+    }
+
+    const char *rest = arg + best_len + 1;
+    int arity = best->struct_node ? best->struct_node->strct.generic_param_count : 1;
+    char *inner;
+    if (arity > 1)
+    {
+        // Only flat argument lists (`Pair_T_U`) can be split back apart.
+        int parts = 1;
+        for (const char *q = rest; *q; q++)
+        {
+            parts += (*q == '_');
+        }
+        if (parts != arity)
+        {
+            return xstrdup(arg);
+        }
+        inner = xstrdup(rest);
+        for (char *q = inner; *q; q++)
+        {
+            if (*q == '_')
+            {
+                *q = ',';
+            }
+        }
+    }
+    else
+    {
+        inner = generic_dep_spelling(ctx, rest);
+    }
+
+    char *res = xmalloc(best_len + strlen(inner) + 3);
+    sprintf(res, "%s<%s>", best->name, inner);
+    free(inner);
+    return res;
+}
+
+char *generic_dep_name(ParserContext *ctx, const char *base, char **args, int count)
+{
+    // `Vec<T>` still mangles to `Vec_T`: a single parameter substitutes as a suffix.
+    if (count == 1 && (is_known_generic(ctx, args[0]) || !type_name_is_generic_dep(ctx, args[0])))
+    {
+        return NULL;
+    }
+
+    size_t cap = strlen(base) + 3;
+    char **parts = xmalloc(sizeof(char *) * count);
+    for (int i = 0; i < count; i++)
+    {
+        parts[i] = generic_dep_spelling(ctx, args[i]);
+        cap += strlen(parts[i]) + 1;
+    }
+    char *res = xmalloc(cap);
+    strcpy(res, base);
+    strcat(res, "<");
+    for (int i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            strcat(res, ",");
+        }
+        strcat(res, parts[i]);
+        free(parts[i]);
+    }
+    strcat(res, ">");
+    free(parts);
+    return res;
+}
+
+// Finds `len` bytes of `tok` in the comma separated `params` list and returns
+// the matching entry of `concrete`, or NULL.
+static char *lookup_param_concrete(const char *tok, int len, const char *params,
+                                   const char *concrete)
+{
+    const char *p = params;
+    const char *c = concrete;
+    while (p && c && *p)
+    {
+        const char *p_end = strchr(p, ',');
+        int p_len = p_end ? (int)(p_end - p) : (int)strlen(p);
+        const char *c_end = strchr(c, ',');
+        int c_len = c_end ? (int)(c_end - c) : (int)strlen(c);
+        if (p_len == len && strncmp(p, tok, len) == 0)
+        {
+            char *res = xmalloc(c_len + 1);
+            strncpy(res, c, c_len);
+            res[c_len] = 0;
+            return res;
+        }
+        p = p_end ? p_end + 1 : NULL;
+        c = c_end ? c_end + 1 : NULL;
+    }
+    return NULL;
+}
+
+Type *resolve_generic_spelling(const char *name, const char *params, const char *concrete)
+{
+    size_t cap = strlen(name) + 1;
+    char *out = xmalloc(cap);
+    size_t n = 0;
+    int still_generic = 0;
+
+    const char *s = name;
+    while (*s)
+    {
+        const char *tok = s;
+        char *rep = NULL;
+        if (isalpha((unsigned char)*s) || *s == '_')
+        {
+            while (isalnum((unsigned char)*s) || *s == '_')
+            {
+                s++;
+            }
+            rep = lookup_param_concrete(tok, (int)(s - tok), params, concrete);
+            if (!rep && s - tok == 1 && isupper((unsigned char)*tok))
+            {
+                still_generic = 1;
+            }
+        }
+        else
+        {
+            s++;
+        }
+
+        const char *piece = rep ? rep : tok;
+        size_t len = rep ? strlen(rep) : (size_t)(s - tok);
+        if (n + len + 1 > cap)
+        {
+            cap = (n + len + 1) * 2;
+            out = xrealloc(out, cap);
+        }
+        memcpy(out + n, piece, len);
+        n += len;
+        free(rep);
+    }
+    out[n] = 0;
+
+    if (still_generic || !g_parser_ctx)
+    {
+        Type *t = type_new(TYPE_STRUCT);
+        t->name = out;
+        return t;
+    }
+
+    Lexer lx;
+    lexer_init(&lx, out);
+    return parse_type_formal(g_parser_ctx, &lx);
+}
+
 void register_impl_template(ParserContext *ctx, const char *sname, const char *param, ASTNode *node)
 {
     GenericImplTemplate *t = xmalloc(sizeof(GenericImplTemplate));
@@ -517,8 +734,27 @@ void register_builtins(ParserContext *ctx)
     register_struct_def(ctx, "va_list", va_def);
 }
 
+// Monomorphized code is private to the program being built: internal linkage
+// lets the C compiler fold whole iterator/closure chains into their callers.
+static void mark_internal(ASTNode *fn)
+{
+    if (fn->type == NODE_FUNCTION)
+    {
+        fn->func.is_internal = !fn->func.is_export;
+        return;
+    }
+    ASTNode *m = fn->type == NODE_IMPL         ? fn->impl.methods
+                 : fn->type == NODE_IMPL_TRAIT ? fn->impl_trait.methods
+                                               : NULL;
+    for (; m; m = m->next)
+    {
+        mark_internal(m);
+    }
+}
+
 void add_instantiated_func(ParserContext *ctx, ASTNode *fn)
 {
+    mark_internal(fn);
     fn->next = ctx->instantiated_funcs;
     ctx->instantiated_funcs = fn;
 }
@@ -1035,6 +1271,31 @@ char *replace_type_str(const char *src, const char *param, const char *concrete,
         return NULL;
     }
 
+    // The closure type is not generic; its "_T" is not a mangled parameter.
+    if (strcmp(src, "z_closure_T") == 0)
+    {
+        return xstrdup(src);
+    }
+
+    if (strchr(src, '<'))
+    {
+        // Static calls carry the method after the type: `Option<Pair<T,U>>__None`.
+        const char *close = strrchr(src, '>');
+        if (close[1])
+        {
+            char *type_part = xmalloc(close - src + 2);
+            strncpy(type_part, src, close - src + 1);
+            type_part[close - src + 1] = 0;
+            char *resolved = type_to_string(resolve_generic_spelling(type_part, param, concrete));
+            char *res = xmalloc(strlen(resolved) + strlen(close + 1) + 1);
+            sprintf(res, "%s%s", resolved, close + 1);
+            free(type_part);
+            free(resolved);
+            return res;
+        }
+        return type_to_string(resolve_generic_spelling(src, param, concrete));
+    }
+
     // Handle multi-param match
     if (param && concrete && strchr(param, ','))
     {
@@ -1145,6 +1406,33 @@ char *replace_type_str(const char *src, const char *param, const char *concrete,
         }
     }
 
+    // One parameter of a list on its own, e.g. Option_V inside impl Map<K, V>.
+    if (param && concrete && strchr(param, ','))
+    {
+        char *res = xstrdup(src);
+        char *p_list = xstrdup(param);
+        char *c_list = xstrdup(concrete);
+        char *p_save;
+        char *c_save;
+        char *p_tok = strtok_r(p_list, ",", &p_save);
+        char *c_tok = strtok_r(c_list, ",", &c_save);
+        while (p_tok && c_tok)
+        {
+            char *next = replace_type_str(res, p_tok, c_tok, NULL, NULL);
+            free(res);
+            res = next;
+            p_tok = strtok_r(NULL, ",", &p_save);
+            c_tok = strtok_r(NULL, ",", &c_save);
+        }
+        free(p_list);
+        free(c_list);
+        if (strcmp(res, src) != 0)
+        {
+            return res;
+        }
+        free(res);
+    }
+
     size_t len = strlen(src);
     if (len > 1 && src[len - 1] == '*')
     {
@@ -1325,6 +1613,11 @@ Type *replace_type_formal(Type *t, const char *p, const char *c, const char *os,
         return NULL;
     }
 
+    if (t->kind == TYPE_STRUCT && t->name && strchr(t->name, '<'))
+    {
+        return resolve_generic_spelling(t->name, p, c);
+    }
+
     // Exact Match Logic (with multi-param splitting)
     if ((t->kind == TYPE_STRUCT || t->kind == TYPE_GENERIC) && t->name)
     {
@@ -1430,6 +1723,17 @@ Type *replace_type_formal(Type *t, const char *p, const char *c, const char *os,
                 n->arg_count = 0;
                 n->args = NULL;
             }
+            else if (strchr(p, ','))
+            {
+                // A mangled name may use only some of the parameters (Option_V).
+                n->name = replace_type_str(t->name, p, c, NULL, NULL);
+                if (strcmp(n->name, t->name) != 0)
+                {
+                    n->kind = TYPE_STRUCT;
+                    n->arg_count = 0;
+                    n->args = NULL;
+                }
+            }
             else
             {
                 n->name = xstrdup(t->name);
@@ -1441,7 +1745,8 @@ Type *replace_type_formal(Type *t, const char *p, const char *c, const char *os,
         }
     }
 
-    if (t->kind == TYPE_POINTER || t->kind == TYPE_ARRAY)
+    // For function types `inner` is the return type.
+    if (t->kind == TYPE_POINTER || t->kind == TYPE_ARRAY || t->kind == TYPE_FUNCTION)
     {
         n->inner = replace_type_formal(t->inner, p, c, os, ns);
     }
@@ -1527,6 +1832,62 @@ char *replace_mangled_part(const char *src, const char *param, const char *concr
     return xstrdup(result);
 }
 
+// Like replace_mangled_part(), for a comma-separated parameter list (`K,V`)
+// and the concrete types at the same positions (`int,char*`).
+static char *replace_mangled_params(const char *src, const char *p, const char *c)
+{
+    if (!strchr(p, ','))
+    {
+        char *clean_c = sanitize_mangled_name(c);
+        char *res = replace_mangled_part(src, p, clean_c);
+        free(clean_c);
+        return res;
+    }
+
+    char *res = xstrdup(src);
+    char *p_list = xstrdup(p);
+    char *c_list = xstrdup(c);
+    char *p_save;
+    char *c_save;
+    char *p_tok = strtok_r(p_list, ",", &p_save);
+    char *c_tok = strtok_r(c_list, ",", &c_save);
+    while (p_tok && c_tok)
+    {
+        char *next = replace_mangled_params(res, p_tok, c_tok);
+        free(res);
+        res = next;
+        p_tok = strtok_r(NULL, ",", &p_save);
+        c_tok = strtok_r(NULL, ",", &c_save);
+    }
+    free(p_list);
+    free(c_list);
+    return res;
+}
+
+// Substitutes type parameters in an emitted C type such as `T*`.
+static char *replace_c_type_text(const char *src, const char *p, const char *c, const char *os,
+                                 const char *ns)
+{
+    if (!src || strcmp(src, "z_closure_T") == 0)
+    {
+        return src ? xstrdup(src) : NULL;
+    }
+    char *res = replace_in_string(src, p, c);
+    if (os && ns)
+    {
+        char *tmp = replace_in_string(res, os, ns);
+        free(res);
+        res = tmp;
+    }
+    if (p && c)
+    {
+        char *tmp = replace_mangled_params(res, p, c);
+        free(res);
+        res = tmp;
+    }
+    return res;
+}
+
 ASTNode *copy_ast_replacing(ASTNode *n, const char *p, const char *c, const char *os,
                             const char *ns)
 {
@@ -1561,9 +1922,7 @@ ASTNode *copy_ast_replacing(ASTNode *n, const char *p, const char *c, const char
         }
         if (p && c)
         {
-            char *clean_c = sanitize_mangled_name(c);
-            char *tmp3 = replace_mangled_part(tmp_args, p, clean_c);
-            free(clean_c);
+            char *tmp3 = replace_mangled_params(tmp_args, p, c);
             free(tmp_args);
             tmp_args = tmp3;
         }
@@ -1597,9 +1956,7 @@ ASTNode *copy_ast_replacing(ASTNode *n, const char *p, const char *c, const char
 
         if (p && c)
         {
-            char *clean_c = sanitize_mangled_name(c);
-            char *s3 = replace_mangled_part(s1, p, clean_c);
-            free(clean_c);
+            char *s3 = replace_mangled_params(s1, p, c);
             free(s1);
             s1 = s3;
         }
@@ -1633,11 +1990,15 @@ ASTNode *copy_ast_replacing(ASTNode *n, const char *p, const char *c, const char
     case NODE_EXPR_VAR:
     {
         char *n1 = xstrdup(n->var_ref.name);
-        if (p && c)
+        if (p && c && strchr(n1, '<'))
+        {
+            char *n2 = replace_type_str(n1, p, c, NULL, NULL);
+            free(n1);
+            n1 = n2;
+        }
+        else if (p && c)
         {
-            char *clean_c = sanitize_mangled_name(c);
-            char *n2 = replace_mangled_part(n1, p, clean_c);
-            free(clean_c);
+            char *n2 = replace_mangled_params(n1, p, c);
             free(n1);
             n1 = n2;
         }
@@ -1764,6 +2125,43 @@ ASTNode *copy_ast_replacing(ASTNode *n, const char *p, const char *c, const char
         }
         new_node->size_of.expr = copy_ast_replacing(n->size_of.expr, p, c, os, ns);
         break;
+    case NODE_LAMBDA:
+    {
+        // A lambda inside a template is specialized like the code around it,
+        // so every copy is emitted as its own `_lambda_N`.
+        ParserContext *ctx = g_parser_ctx;
+        if (!ctx)
+        {
+            break;
+        }
+        new_node->lambda.lambda_id = ctx->lambda_counter++;
+        new_node->lambda.return_type = replace_c_type_text(n->lambda.return_type, p, c, os, ns);
+        new_node->lambda.param_types = xmalloc(sizeof(char *) * (n->lambda.num_params + 1));
+        for (int i = 0; i < n->lambda.num_params; i++)
+        {
+            new_node->lambda.param_types[i] =
+                replace_c_type_text(n->lambda.param_types[i], p, c, os, ns);
+        }
+        new_node->lambda.captured_types = xmalloc(sizeof(char *) * (n->lambda.num_captures + 1));
+        for (int i = 0; i < n->lambda.num_captures; i++)
+        {
+            new_node->lambda.captured_types[i] =
+                replace_c_type_text(n->lambda.captured_types[i], p, c, os, ns);
+        }
+        new_node->lambda.body = copy_ast_replacing(n->lambda.body, p, c, os, ns);
+        register_lambda(ctx, new_node);
+
+        // The template's own lambda still names the type parameters.
+        for (LambdaRef **ref = &ctx->global_lambdas; *ref; ref = &(*ref)->next)
+        {
+            if ((*ref)->node == n)
+            {
+                *ref = (*ref)->next;
+                break;
+            }
+        }
+        break;
+    }
     default:
         break;
     }
@@ -1854,6 +2252,57 @@ char *unmangle_ptr_suffix(const char *s)
     return result;
 }
 
+// Detached copy of an impl node carrying `methods`, so a subset of a template's
+// methods can be instantiated without relinking the template itself.
+static ASTNode *impl_shell(ASTNode *impl, ASTNode *methods)
+{
+    ASTNode *shell = xmalloc(sizeof(ASTNode));
+    *shell = *impl;
+    shell->next = NULL;
+    if (impl->type == NODE_IMPL)
+    {
+        shell->impl.methods = methods;
+    }
+    return shell;
+}
+
+// Copies a method deferred by instantiate_methods() into its instantiated impl.
+static void trigger_body_instantiations(ParserContext *ctx, ASTNode *node,
+                                        const char *concrete);
+
+static FuncSig *instantiate_lazy_method(ParserContext *ctx, const char *name)
+{
+    LazyMethod **pp = &ctx->lazy_methods;
+    while (*pp && strcmp((*pp)->name, name) != 0)
+    {
+        pp = &(*pp)->next;
+    }
+    if (!*pp)
+    {
+        return NULL;
+    }
+    LazyMethod *lm = *pp;
+    *pp = lm->next;
+
+    GenericImplTemplate *it = lm->impl;
+    ASTNode *link = xmalloc(sizeof(ASTNode));
+    *link = *lm->method;
+    link->next = NULL;
+    ASTNode *new_impl = copy_ast_replacing(impl_shell(it->impl_node, link), it->generic_param,
+                                           lm->subst_arg, it->struct_name, lm->struct_name);
+
+    new_impl->impl.struct_name = xstrdup(lm->struct_name);
+    ASTNode *meth = new_impl->impl.methods;
+    free(meth->func.name);
+    meth->func.name = xstrdup(lm->name);
+    register_func(ctx, meth->func.name, meth->func.arg_count, meth->func.defaults,
+                  meth->func.arg_types, meth->func.ret_type_info, meth->func.is_varargs, 0,
+                  meth->token);
+    add_instantiated_func(ctx, new_impl);
+    trigger_body_instantiations(ctx, meth->func.body, lm->subst_arg);
+    return ctx->func_registry;
+}
+
 FuncSig *find_func(ParserContext *ctx, const char *name)
 {
     FuncSig *c = ctx->func_registry;
@@ -1892,18 +2341,132 @@ FuncSig *find_func(ParserContext *ctx, const char *name)
         }
     }
 
-    return NULL;
+    return ctx && ctx->lazy_methods ? instantiate_lazy_method(ctx, name) : NULL;
+}
+
+// Instantiates the single-parameter template behind a mangled reference such
+// as `Slice_int64_t` (struct) or `first_of_int32_t` (function). Template bodies
+// spell `Slice<T>` as `Slice_T`, so such references only become concrete when
+// the body is copied for a type, after the parser's own instantiation ran.
+//
+// `concrete` lists the types the body is being specialized for, e.g. `DirEntry*`
+// for the mangled argument `DirEntryPtr`; it recovers their C spelling.
+static void instantiate_mangled_ref(ParserContext *ctx, const char *name, int funcs,
+                                    const char *concrete)
+{
+    if (!name || !strchr(name, '_'))
+    {
+        return;
+    }
+
+    // Static calls carry the method: `Vec_int32_t__new` refers to `Vec_int32_t`,
+    // and so does a pointer type `Vec_int32_t*`.
+    char *ref = xstrdup(name);
+    char *method = strstr(ref, "__");
+    if (method)
+    {
+        *method = 0;
+    }
+    size_t ref_len = strlen(ref);
+    while (ref_len > 0 && (ref[ref_len - 1] == '*' || ref[ref_len - 1] == ' '))
+    {
+        ref[--ref_len] = 0;
+    }
+
+    const char *tpl = NULL;
+    size_t tpl_len = 0;
+    for (GenericTemplate *gt = ctx->templates; gt; gt = gt->next)
+    {
+        size_t len = strlen(gt->name);
+        int params = (gt->struct_node && gt->struct_node->type == NODE_STRUCT)
+                         ? gt->struct_node->strct.generic_param_count
+                         : 1;
+        if (params == 1 && len > tpl_len && strncmp(ref, gt->name, len) == 0 &&
+            ref[len] == '_' && ref[len + 1])
+        {
+            tpl = gt->name;
+            tpl_len = len;
+        }
+    }
+
+    int is_func = 0;
+    if (!tpl && funcs && !method && !find_func(ctx, ref))
+    {
+        for (GenericFuncTemplate *ft = ctx->func_templates; ft; ft = ft->next)
+        {
+            size_t len = strlen(ft->name);
+            if (!strchr(ft->generic_param, ',') && len > tpl_len &&
+                strncmp(ref, ft->name, len) == 0 && ref[len] == '_' && ref[len + 1])
+            {
+                tpl = ft->name;
+                tpl_len = len;
+                is_func = 1;
+            }
+        }
+    }
+
+    const char *arg = tpl ? ref + tpl_len + 1 : NULL;
+    if (arg && !(strlen(arg) == 1 && isupper(arg[0])) && !is_known_generic(ctx, (char *)arg))
+    {
+        char *tpl_name = xstrdup(tpl);
+        char *unmangled = NULL;
+        char *list = concrete ? xstrdup(concrete) : NULL;
+        char *save = NULL;
+        for (char *tok = list ? strtok_r(list, ",", &save) : NULL; tok && !unmangled;
+             tok = strtok_r(NULL, ",", &save))
+        {
+            char *clean = sanitize_mangled_name(tok);
+            if (strcmp(clean, arg) == 0)
+            {
+                unmangled = xstrdup(tok);
+            }
+            free(clean);
+        }
+        free(list);
+        if (!unmangled)
+        {
+            unmangled = unmangle_ptr_suffix(arg);
+        }
+        if (is_func)
+        {
+            instantiate_function_template(ctx, tpl_name, arg, unmangled);
+        }
+        else
+        {
+            Token dummy_tok = {0};
+            instantiate_generic(ctx, tpl_name, arg, unmangled, dummy_tok);
+        }
+        free(unmangled);
+        free(tpl_name);
+    }
+    free(ref);
 }
 
-// Helper function to recursively scan AST for sizeof types and trigger instantiation of generic
-// structs
-static void trigger_sizeof_instantiations(ParserContext *ctx, ASTNode *node)
+// Helper function to recursively scan a copied body for generic references
+// (sizeof types, struct literals, declared types, called functions) and
+// trigger their instantiation.
+static void trigger_body_instantiations(ParserContext *ctx, ASTNode *node,
+                                        const char *concrete)
 {
     if (!node)
     {
         return;
     }
 
+    if (node->type == NODE_EXPR_STRUCT_INIT)
+    {
+        instantiate_mangled_ref(ctx, node->struct_init.struct_name, 0, concrete);
+    }
+    else if (node->type == NODE_VAR_DECL && node->var_decl.type_str)
+    {
+        instantiate_mangled_ref(ctx, node->var_decl.type_str, 0, concrete);
+    }
+    else if (node->type == NODE_EXPR_CALL && node->call.callee &&
+             node->call.callee->type == NODE_EXPR_VAR)
+    {
+        instantiate_mangled_ref(ctx, node->call.callee->var_ref.name, 1, concrete);
+    }
+
     // Process current node
     if (node->type == NODE_EXPR_SIZEOF && node->size_of.target_type)
     {
@@ -1963,59 +2526,74 @@ static void trigger_sizeof_instantiations(ParserContext *ctx, ASTNode *node)
     switch (node->type)
     {
     case NODE_FUNCTION:
-        trigger_sizeof_instantiations(ctx, node->func.body);
+        trigger_body_instantiations(ctx, node->func.body, concrete);
         break;
     case NODE_BLOCK:
-        trigger_sizeof_instantiations(ctx, node->block.statements);
+        trigger_body_instantiations(ctx, node->block.statements, concrete);
         break;
     case NODE_VAR_DECL:
-        trigger_sizeof_instantiations(ctx, node->var_decl.init_expr);
+        trigger_body_instantiations(ctx, node->var_decl.init_expr, concrete);
+        break;
+    case NODE_EXPR_STRUCT_INIT:
+        for (ASTNode *f = node->struct_init.fields; f; f = f->next)
+        {
+            trigger_body_instantiations(ctx, f->var_decl.init_expr, concrete);
+        }
+        break;
+    case NODE_LAMBDA:
+        trigger_body_instantiations(ctx, node->lambda.body, concrete);
         break;
     case NODE_RETURN:
-        trigger_sizeof_instantiations(ctx, node->ret.value);
+        trigger_body_instantiations(ctx, node->ret.value, concrete);
         break;
     case NODE_EXPR_BINARY:
-        trigger_sizeof_instantiations(ctx, node->binary.left);
-        trigger_sizeof_instantiations(ctx, node->binary.right);
+        trigger_body_instantiations(ctx, node->binary.left, concrete);
+        trigger_body_instantiations(ctx, node->binary.right, concrete);
         break;
     case NODE_EXPR_UNARY:
-        trigger_sizeof_instantiations(ctx, node->unary.operand);
+        trigger_body_instantiations(ctx, node->unary.operand, concrete);
         break;
     case NODE_EXPR_CALL:
-        trigger_sizeof_instantiations(ctx, node->call.callee);
-        trigger_sizeof_instantiations(ctx, node->call.args);
+        trigger_body_instantiations(ctx, node->call.callee, concrete);
+        trigger_body_instantiations(ctx, node->call.args, concrete);
         break;
     case NODE_EXPR_MEMBER:
-        trigger_sizeof_instantiations(ctx, node->member.target);
+        trigger_body_instantiations(ctx, node->member.target, concrete);
         break;
     case NODE_EXPR_INDEX:
-        trigger_sizeof_instantiations(ctx, node->index.array);
-        trigger_sizeof_instantiations(ctx, node->index.index);
+        trigger_body_instantiations(ctx, node->index.array, concrete);
+        trigger_body_instantiations(ctx, node->index.index, concrete);
         break;
     case NODE_EXPR_CAST:
-        trigger_sizeof_instantiations(ctx, node->cast.expr);
+        trigger_body_instantiations(ctx, node->cast.expr, concrete);
         break;
     case NODE_IF:
-        trigger_sizeof_instantiations(ctx, node->if_stmt.condition);
-        trigger_sizeof_instantiations(ctx, node->if_stmt.then_body);
-        trigger_sizeof_instantiations(ctx, node->if_stmt.else_body);
+        trigger_body_instantiations(ctx, node->if_stmt.condition, concrete);
+        trigger_body_instantiations(ctx, node->if_stmt.then_body, concrete);
+        trigger_body_instantiations(ctx, node->if_stmt.else_body, concrete);
         break;
     case NODE_WHILE:
-        trigger_sizeof_instantiations(ctx, node->while_stmt.condition);
-        trigger_sizeof_instantiations(ctx, node->while_stmt.body);
+        trigger_body_instantiations(ctx, node->while_stmt.condition, concrete);
+        trigger_body_instantiations(ctx, node->while_stmt.body, concrete);
+        break;
+    case NODE_FOR_RANGE:
+        trigger_body_instantiations(ctx, node->for_range.body, concrete);
+        break;
+    case NODE_LOOP:
+        trigger_body_instantiations(ctx, node->loop_stmt.body, concrete);
         break;
     case NODE_FOR:
-        trigger_sizeof_instantiations(ctx, node->for_stmt.init);
-        trigger_sizeof_instantiations(ctx, node->for_stmt.condition);
-        trigger_sizeof_instantiations(ctx, node->for_stmt.step);
-        trigger_sizeof_instantiations(ctx, node->for_stmt.body);
+        trigger_body_instantiations(ctx, node->for_stmt.init, concrete);
+        trigger_body_instantiations(ctx, node->for_stmt.condition, concrete);
+        trigger_body_instantiations(ctx, node->for_stmt.step, concrete);
+        trigger_body_instantiations(ctx, node->for_stmt.body, concrete);
         break;
     default:
         break;
     }
 
     // Visit next sibling
-    trigger_sizeof_instantiations(ctx, node->next);
+    trigger_body_instantiations(ctx, node->next, concrete);
 }
 
 char *instantiate_function_template(ParserContext *ctx, const char *name, const char *concrete_type,
@@ -2157,9 +2735,9 @@ char *instantiate_function_template(ParserContext *ctx, const char *name, const
         return NULL;
     }
 
-    // Scan the function body for sizeof expressions and trigger instantiation
+    // Scan the function body for generic references and trigger instantiation
     // of any generic structs referenced there (e.g., sizeof(RcInner_int32_t))
-    trigger_sizeof_instantiations(ctx, new_fn->func.body);
+    trigger_body_instantiations(ctx, new_fn->func.body, subst_arg);
 
     free(new_fn->func.name);
     new_fn->func.name = xstrdup(mangled);
@@ -2447,26 +3025,103 @@ ASTNode *copy_fields_replacing(ParserContext *ctx, ASTNode *fields, const char *
     return n;
 }
 
+// Instantiates a multi-parameter template named in a method signature. The
+// arguments are either spelled out (`Pair<int,char*>`) or mangled
+// (`Pair_int_charPtr`); a mangled list cannot be split reliably, so it is only
+// accepted when it is the argument list of the impl being instantiated.
+static void instantiate_generic_from_list(ParserContext *ctx, const char *tpl, const char *list,
+                                          char delim, const char *impl_args, Token token)
+{
+    char *source = NULL;
+    if (delim == '<')
+    {
+        source = xstrdup(list);
+    }
+    else
+    {
+        char *clean_impl = sanitize_mangled_name(impl_args);
+        if (strcmp(clean_impl, list) == 0)
+        {
+            source = xstrdup(impl_args);
+        }
+        free(clean_impl);
+    }
+    if (!source)
+    {
+        return;
+    }
+
+    char *args[16];
+    int count = 0;
+    char *saveptr;
+    for (char *tok = strtok_r(source, ",", &saveptr); tok && count < 16;
+         tok = strtok_r(NULL, ",", &saveptr))
+    {
+        while (*tok == ' ')
+        {
+            tok++;
+        }
+        args[count++] = tok;
+    }
+    instantiate_generic_multi(ctx, tpl, args, count, token);
+    free(source);
+}
+
 void instantiate_methods(ParserContext *ctx, GenericImplTemplate *it,
                          const char *mangled_struct_name, const char *arg,
                          const char *unmangled_arg)
 {
+    const char *unmangled_arg_list = unmangled_arg ? unmangled_arg : arg;
     if (check_impl(ctx, "Methods", mangled_struct_name))
     {
         return; // Simple dedupe check
     }
 
-    ASTNode *backup_next = it->impl_node->next;
-    it->impl_node->next = NULL; // Break link to isolate node
-
     // Use unmangled_arg if provided, otherwise arg
     char *raw = (char *)(unmangled_arg ? unmangled_arg : arg);
     char *subst_arg = unmangle_ptr_suffix(raw);
 
-    ASTNode *new_impl = copy_ast_replacing(it->impl_node, it->generic_param, subst_arg,
+    // Methods returning a new instance of their own generic (`Iter<IterFilter<I, T>, T>`
+    // inside `impl Iter<I, T>`) are copied only when first called; instantiating
+    // them eagerly would build an endless chain of wrapper types. The template is
+    // shared with nested instantiations, so the remaining methods are copied from
+    // a shell instead of unlinking them in place.
+    ASTNode *src_impl = impl_shell(it->impl_node, NULL);
+    if (it->impl_node->type == NODE_IMPL)
+    {
+        size_t slen = strlen(it->struct_name);
+        char *self_type = xmalloc(slen + strlen(it->generic_param) + 3);
+        sprintf(self_type, "%s<%s>", it->struct_name, it->generic_param);
+        ASTNode **tail = &src_impl->impl.methods;
+        for (ASTNode *m = it->impl_node->impl.methods; m; m = m->next)
+        {
+            const char *ret = m->type == NODE_FUNCTION ? m->func.ret_type : NULL;
+            if (ret && !m->func.generic_params && strncmp(ret, it->struct_name, slen) == 0 &&
+                ret[slen] == '<' && strcmp(ret, self_type) != 0)
+            {
+                LazyMethod *lm = xmalloc(sizeof(LazyMethod));
+                lm->name = xmalloc(strlen(mangled_struct_name) + strlen(m->func.name) + 1);
+                sprintf(lm->name, "%s%s", mangled_struct_name, m->func.name + slen);
+                lm->impl = it;
+                lm->method = m;
+                lm->struct_name = xstrdup(mangled_struct_name);
+                lm->subst_arg = xstrdup(subst_arg);
+                lm->next = ctx->lazy_methods;
+                ctx->lazy_methods = lm;
+                continue;
+            }
+            ASTNode *link = xmalloc(sizeof(ASTNode));
+            *link = *m;
+            link->next = NULL;
+            *tail = link;
+            tail = &link->next;
+        }
+        free(self_type);
+    }
+
+    ASTNode *new_impl = copy_ast_replacing(src_impl, it->generic_param, subst_arg,
                                            it->struct_name, mangled_struct_name);
     free(subst_arg);
-    it->impl_node->next = backup_next; // Restore
 
     ASTNode *meth = NULL;
 
@@ -2490,13 +3145,22 @@ void instantiate_methods(ParserContext *ctx, GenericImplTemplate *it,
             sprintf(new_name, "%s%s", mangled_struct_name, suffix);
             free(meth->func.name);
             meth->func.name = new_name;
-            register_func(ctx, new_name, meth->func.arg_count, meth->func.defaults,
-                          meth->func.arg_types, meth->func.ret_type_info, meth->func.is_varargs, 0,
-                          meth->token);
+            if (meth->func.generic_params)
+            {
+                // A method with its own type parameters stays a template; calls
+                // like `it.map<U>(f)` instantiate it for this struct.
+                register_func_template(ctx, new_name, meth->func.generic_params, meth);
+            }
+            else
+            {
+                register_func(ctx, new_name, meth->func.arg_count, meth->func.defaults,
+                              meth->func.arg_types, meth->func.ret_type_info,
+                              meth->func.is_varargs, 0, meth->token);
+            }
         }
 
         // Handle generic return types in methods (e.g., Option<T> -> Option_int)
-        if (meth->func.ret_type &&
+        if (meth->func.ret_type && !meth->func.generic_params &&
             (strchr(meth->func.ret_type, '_') || strchr(meth->func.ret_type, '<')))
         {
             GenericTemplate *gt = ctx->templates;
@@ -2551,7 +3215,18 @@ void instantiate_methods(ParserContext *ctx, GenericImplTemplate *it,
                         free(base);
                     }
 
-                    instantiate_generic(ctx, gt->name, clean_arg, unmangled_arg, meth->token);
+                    int gt_params = (gt->struct_node && gt->struct_node->type == NODE_STRUCT)
+                                        ? gt->struct_node->strct.generic_param_count
+                                        : 1;
+                    if (gt_params > 1)
+                    {
+                        instantiate_generic_from_list(ctx, gt->name, clean_arg, delim,
+                                                      unmangled_arg_list, meth->token);
+                    }
+                    else
+                    {
+                        instantiate_generic(ctx, gt->name, clean_arg, unmangled_arg, meth->token);
+                    }
                     free(unmangled_arg);
                     free(clean_arg);
                 }
@@ -2559,6 +3234,10 @@ void instantiate_methods(ParserContext *ctx, GenericImplTemplate *it,
             }
         }
 
+        if (!meth->func.generic_params)
+        {
+            trigger_body_instantiations(ctx, meth->func.body, raw);
+        }
         meth = meth->next;
     }
     add_instantiated_func(ctx, new_impl);
@@ -2579,7 +3258,7 @@ void instantiate_generic(ParserContext *ctx, const char *tpl, const char *arg,
     }
 
     char *clean_arg = sanitize_mangled_name(arg);
-    char m[256];
+    char m[1024];
     sprintf(m, "%s_%s", tpl, clean_arg);
     free(clean_arg);
 
@@ -2673,7 +3352,7 @@ void instantiate_generic(ParserContext *ctx, const char *tpl, const char *arg,
             const char *subst_arg = unmangled_arg ? unmangled_arg : arg;
             nv->variant.payload = replace_type_formal(
                 v->variant.payload, t->struct_node->enm.generic_param, subst_arg, NULL, NULL);
-            char mangled_var[512];
+            char mangled_var[1280];
             sprintf(mangled_var, "%s_%s", m, nv->variant.name);
             register_enum_variant(ctx, m, mangled_var, nv->variant.tag_id);
             if (!h)
@@ -2715,7 +3394,7 @@ void instantiate_generic_multi(ParserContext *ctx, const char *tpl, char **args,
                                Token token)
 {
     // Build mangled name from all args
-    char m[256];
+    char m[1024];
     strcpy(m, tpl);
     for (int i = 0; i < arg_count; i++)
     {
@@ -2809,6 +3488,34 @@ void instantiate_generic_multi(ParserContext *ctx, const char *tpl, char **args,
         i->next = ctx->instantiated_structs;
         ctx->instantiated_structs = i;
     }
+
+    // Methods: impl templates take the arguments comma-joined, like their parameters.
+    size_t joined_len = 1;
+    for (int i = 0; i < arg_count; i++)
+    {
+        joined_len += strlen(args[i]) + 1;
+    }
+    char *joined = xmalloc(joined_len);
+    joined[0] = 0;
+    for (int i = 0; i < arg_count; i++)
+    {
+        if (i > 0)
+        {
+            strcat(joined, ",");
+        }
+        strcat(joined, args[i]);
+    }
+
+    GenericImplTemplate *it = ctx->impl_templates;
+    while (it)
+    {
+        if (strcmp(it->struct_name, tpl) == 0)
+        {
+            instantiate_methods(ctx, it, m, joined, joined);
+        }
+        it = it->next;
+    }
+    free(joined);
 }
 
 int is_file_imported(ParserContext *ctx, const char *p)
@@ -3293,7 +4000,7 @@ char *rewrite_expr_methods(ParserContext *ctx, char *raw)
                 {
                     src++;
 
-                    char mangled[256];
+                    char mangled[1024];
 
                     const char *aliased = find_type_alias(ctx, func_name);
                     const char *use_name = aliased ? aliased : func_name;
@@ -3474,11 +4181,15 @@ char *parse_and_convert_args(ParserContext *ctx, Lexer *l, char ***defaults_out,
                     {
                         st = type_new(TYPE_STRING);
                     }
-                    // Add other primitives as needed
                     else
                     {
-                        st = type_new(TYPE_STRUCT);
-                        st->name = xstrdup(ctx->current_impl_struct);
+                        // Sized integers (u8, i64, usize, ...) keep their numeric kind.
+                        st = type_from_string_helper(ctx->current_impl_struct);
+                        if (!st || !is_integer_type(st))
+                        {
+                            st = type_new(TYPE_STRUCT);
+                            st->name = xstrdup(ctx->current_impl_struct);
+                        }
                     }
                     Type *pt = type_new_ptr(st);
 
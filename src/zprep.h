@@ -351,6 +351,7 @@ typedef struct
     // Modes.
     int mode_run;        ///< 1 if 'run' command (compile & execute).
     int mode_check;      ///< 1 if 'check' command (syntax/type check only).
+    int mode_bench;      ///< 1 if 'bench' command (compile & run bench blocks).
     int emit_c;          ///< 1 if --emit-c (keep generated C file).
     int verbose;         ///< 1 if --verbose.
     int quiet;           ///< 1 if --quiet.
@@ -365,6 +366,8 @@ typedef struct
 
     int keep_comments; ///< 1 if --keep-comments (preserve comments in output).
 
+    char bench_args[1024]; ///< Runner flags forwarded by 'bench' (--filter, --json, --time).
+
     // GCC Flags accumulator.
     char gcc_flags[4096]; ///< Flags passed to the backend compiler.
 
@@ -0,0 +1,18 @@
+
+#ifndef CALLBACK_LIB_H
+#define CALLBACK_LIB_H
+
+/**
+ * @brief Implemented in Zen; only referenced from this header.
+ */
+int zen_callback(int x);
+
+/**
+ * @brief Calls back into Zen code.
+ * @return zen_callback(41).
+ */
+static int call_zen_callback() {
+    return zen_callback(41);
+}
+
+#endif
@@ -35,8 +35,98 @@ else
     fi
 fi
 
+# Test 2: Constant Folding / Dead Branches
+TEST_NAME="const_fold.zc"
+echo -n "Testing $TEST_DIR/$TEST_NAME (Constant Folding)... "
+
+$ZC "$TEST_DIR/$TEST_NAME" --emit-c > /dev/null 2>&1
+if [ $? -ne 0 ]; then
+    echo "FAIL (Compilation error)"
+    ((FAILED++))
+else
+    # "def SIZE = 4 * 1024" must fold to 4096, the "if DEBUG" body and the
+    # match arms MODE cannot select must be gone, and negative defs must fold
+    if ! grep -q "n = 4096;" out.c; then
+        echo "FAIL (def expression not folded)"
+        ((FAILED++))
+    elif grep -q "debug build" out.c; then
+        echo "FAIL (dead branch emitted)"
+        ((FAILED++))
+    elif grep -q "dead arm one\|dead default" out.c || ! grep -q "live arm" out.c; then
+        echo "FAIL (constant match arms not pruned)"
+        ((FAILED++))
+    elif ! grep -q "o = (-10);" out.c; then
+        echo "FAIL (negative def not folded)"
+        ((FAILED++))
+    else
+        echo "PASS"
+        ((PASSED++))
+    fi
+fi
+
+# Test 3: Unreachable Function Pruning
+TEST_NAME="prune_unused.zc"
+echo -n "Testing $TEST_DIR/$TEST_NAME (Unreachable Pruning)... "
+
+$ZC "$TEST_DIR/$TEST_NAME" --emit-c > /dev/null 2>&1
+if [ $? -ne 0 ]; then
+    echo "FAIL (Compilation error)"
+    ((FAILED++))
+else
+    # Uncalled functions, methods and Vec<int> methods must be gone; live and @export ones kept
+    if grep -q "never_called\|Vec_int32_t__reverse" out.c; then
+        echo "FAIL (unreachable function emitted)"
+        ((FAILED++))
+    elif ! grep -q "exported_fn" out.c || ! grep -q "Counter__bump" out.c; then
+        echo "FAIL (reachable function pruned)"
+        ((FAILED++))
+    else
+        echo "PASS"
+        ((PASSED++))
+    fi
+fi
+
+# Test 4: Bench Blocks
+TEST_NAME="bench_blocks.zc"
+echo -n "Testing $TEST_DIR/$TEST_NAME (Bench Blocks)... "
+
+OUTPUT=$($ZC bench "$TEST_DIR/$TEST_NAME" --time 20 --json bench.json 2>&1)
+if [ $? -ne 0 ]; then
+    echo "FAIL (Compilation error)"
+    ((FAILED++))
+elif echo "$OUTPUT" | grep -q "test ran"; then
+    echo "FAIL (test block run by zc bench)"
+    ((FAILED++))
+elif ! grep -q '"name": "fib", "samples": ' bench.json || ! grep -q 'sum \\"quoted\\"' bench.json; then
+    echo "FAIL (missing JSON results)"
+    ((FAILED++))
+elif $ZC bench "$TEST_DIR/$TEST_NAME" --time 20 --filter "x'; echo injected; '" 2>&1 | grep -q "^injected"; then
+    echo "FAIL (bench args not shell-quoted)"
+    ((FAILED++))
+elif ! $ZC run "$TEST_DIR/$TEST_NAME" 2>&1 | grep -q "test ran"; then
+    echo "FAIL (zc run did not run tests)"
+    ((FAILED++))
+else
+    echo "PASS"
+    ((PASSED++))
+fi
+
+# Test 5: Rvalue receivers in C++ mode
+TEST_NAME="cpp_rvalue_receiver.zc"
+echo -n "Testing $TEST_DIR/$TEST_NAME (C++ Rvalue Receiver)... "
+
+if ! command -v g++ > /dev/null 2>&1; then
+    echo "SKIP (g++ not found)"
+elif ! $ZC run "$TEST_DIR/$TEST_NAME" --cpp 2>&1 | grep -q "^42$"; then
+    echo "FAIL (C++ build of rvalue method call)"
+    ((FAILED++))
+else
+    echo "PASS"
+    ((PASSED++))
+fi
+
 # Cleanup
-rm -f out.c a.out
+rm -f out.c a.out bench.json
 
 echo "----------------------------------------"
 echo "Summary:"